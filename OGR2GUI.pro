@@ -24,7 +24,10 @@
 # *****************************************************************************/
 
 TEMPLATE = app
-INCLUDEPATH += $$PWD/include $$PWD/include/ogr
+# GDAL headers are bundled for Windows, unix takes those of the linked
+# library from pkg-config.
+INCLUDEPATH += $$PWD/include
+win32: INCLUDEPATH += $$PWD/include/ogr
 #DESTDIR += $$PWD/bin
 
 TRANSLATIONS += \
@@ -42,9 +45,24 @@ HEADERS += \
     include/app.h \
     include/ogr.h \
     include/dbConnect.h \
-    include/utils.h \
     include/webServiceConnect.h \
-    include/ogr2ogrThread.h \
+    include/ogr2ogrJob.h \
+    include/conversionQueue.h \
+    include/conversionSpec.h \
+    include/preflight.h \
+    include/sourceProbe.h \
+    include/startupLoader.h \
+    include/startupTimer.h \
+    include/datasetCache.h \
+    include/srsCache.h \
+    include/transformBatch.h \
+    include/transformDataset.h \
+    include/sourceCatalog.h \
+    include/projectionIndex.h \
+    include/projectionModel.h \
+    include/projectionSearch.h \
+    include/ogr2ogrEngine.h \
+    include/ogr2ogrProcess.h \
     include/i18n.h \
     include/settings.h
 
@@ -53,15 +71,29 @@ SOURCES += \
     src/dbConnect.cpp \
     src/app.cpp \
     src/main.cpp \
-    src/utils/ogr2ogr_bin.cpp \
-    src/utils/commonutils.cpp \
     src/webServiceConnect.cpp \
-    src/ogr2ogrThread.cpp \
+    src/ogr2ogrJob.cpp \
+    src/conversionQueue.cpp \
+    src/conversionSpec.cpp \
+    src/preflight.cpp \
+    src/sourceProbe.cpp \
+    src/startupLoader.cpp \
+    src/startupTimer.cpp \
+    src/datasetCache.cpp \
+    src/srsCache.cpp \
+    src/transformBatch.cpp \
+    src/transformDataset.cpp \
+    src/sourceCatalog.cpp \
+    src/projectionIndex.cpp \
+    src/projectionModel.cpp \
+    src/projectionSearch.cpp \
+    src/ogr2ogrEngine.cpp \
+    src/ogr2ogrProcess.cpp \
     src/i18n.cpp \
     src/settings.cpp
 
 CONFIG += c++14
-QT += sql widgets
+QT += sql widgets concurrent
 
 win32: contains(QMAKE_TARGET.arch, x86) {
     TARGET = OGR2GUI
@@ -73,6 +105,12 @@ win32: contains(QMAKE_TARGET.arch, x86_64) {
     LIBS += -L$$PWD/lib -lgdal_i_x64
 }
 
+unix {
+    TARGET = OGR2GUI
+    CONFIG += link_pkgconfig
+    PKGCONFIG += gdal
+}
+
 CONFIG(debug, debug|release) {
     win32: TARGET = $$join(TARGET,,,d)
 }
@@ -0,0 +1,38 @@
+#/*****************************************************************************
+# * OGR2GUI is an application used to convert and manipulate geospatial
+# * data. It is based on the "OGR Simple Feature Library" from the
+# * "Geospatial Data Abstraction Library" <http://gdal.org>.
+# *
+# * Copyright (c) 2014 Faculty of Computer Science,
+# * University of Applied Sciences Rapperswil (HSR),
+# * 8640 Rapperswil, Switzerland
+# * Copyright (c) 2016 David Tran, Switzerland
+# *
+# * This program is free software: you can redistribute it and/or modify
+# * it under the terms of the GNU General Public License as published by
+# * the Free Software Foundation, either version 3 of the License, or
+# * (at your option) any later version.
+# *
+# * This program is distributed in the hope that it will be useful,
+# * but WITHOUT ANY WARRANTY; without even the implied warranty of
+# * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# * GNU General Public License for more details.
+# *
+# * You should have received a copy of the GNU General Public License
+# * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# *****************************************************************************/
+
+
+# Starts OGR2GUI repeatedly with OGR2GUI_STARTUP_TIMING=exit and reports
+# percentiles of the startup phases, see src/bench/benchStartup.cpp
+
+TEMPLATE = app
+TARGET = OGR2GUI_bench
+#DESTDIR += $$PWD/bin
+
+SOURCES += \
+    src/bench/benchStartup.cpp
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+QT -= gui
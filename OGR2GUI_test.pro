@@ -24,17 +24,35 @@
 
 TEMPLATE = app
 TARGET = OGR2GUI_test
-INCLUDEPATH += $$PWD/include $$PWD/include/ogr $$PWD/include/tests
-LIBS += -L$$PWD/lib -lgdal_i
+# GDAL headers are bundled for Windows, unix takes those of the linked
+# library from pkg-config.
+INCLUDEPATH += $$PWD/include $$PWD/include/tests
+win32: INCLUDEPATH += $$PWD/include/ogr
+win32: LIBS += -L$$PWD/lib -lgdal_i
 #DESTDIR += $$PWD/bin
 
 HEADERS += \
     include/app.h \
     include/ogr.h \
     include/dbConnect.h \
-    include/utils.h \
     include/webServiceConnect.h \
-    include/ogr2ogrThread.h \
+    include/ogr2ogrJob.h \
+    include/conversionQueue.h \
+    include/conversionSpec.h \
+    include/preflight.h \
+    include/sourceProbe.h \
+    include/startupLoader.h \
+    include/startupTimer.h \
+    include/datasetCache.h \
+    include/srsCache.h \
+    include/transformBatch.h \
+    include/transformDataset.h \
+    include/sourceCatalog.h \
+    include/projectionIndex.h \
+    include/projectionModel.h \
+    include/projectionSearch.h \
+    include/ogr2ogrEngine.h \
+    include/ogr2ogrProcess.h \
     include/i18n.h \
     include/settings.h \
     include/tests/testDBConnect.h \
@@ -45,15 +63,34 @@ SOURCES += \
     src/dbConnect.cpp \
     src/app.cpp \
     src/webServiceConnect.cpp \
-    src/ogr2ogrThread.cpp \
+    src/ogr2ogrJob.cpp \
+    src/conversionQueue.cpp \
+    src/conversionSpec.cpp \
+    src/preflight.cpp \
+    src/sourceProbe.cpp \
+    src/startupLoader.cpp \
+    src/startupTimer.cpp \
+    src/datasetCache.cpp \
+    src/srsCache.cpp \
+    src/transformBatch.cpp \
+    src/transformDataset.cpp \
+    src/sourceCatalog.cpp \
+    src/projectionIndex.cpp \
+    src/projectionModel.cpp \
+    src/projectionSearch.cpp \
+    src/ogr2ogrEngine.cpp \
+    src/ogr2ogrProcess.cpp \
     src/i18n.cpp \
     src/settings.cpp \
-    src/utils/ogr2ogr_bin.cpp \
-    src/utils/commonutils.cpp \
     src/tests/testDBConnect.cpp \
     src/tests/testMain.cpp \
     src/tests/testOgr.cpp
 SOURCES -= src/main.cpp
 
 CONFIG += c++14
-QT += sql widgets testlib
+QT += sql widgets concurrent testlib
+
+unix {
+    CONFIG += link_pkgconfig
+    PKGCONFIG += gdal
+}
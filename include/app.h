@@ -54,6 +54,12 @@
 #include "dbConnect.h"
 #include "webServiceConnect.h"
 #include "settings.h"
+#include "conversionQueue.h"
+#include "conversionSpec.h"
+#include "preflight.h"
+#include "sourceProbe.h"
+#include "startupLoader.h"
+#include "projectionModel.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -66,8 +72,13 @@ private:
     DBConnect *dbConnect;
     WebServiceConnect *wsConnect;
     Settings *settings;
+    ConversionQueue *queue;
+    SourceProbe *sourceProbe;
+    StartupLoader *startupLoader;
+    QFutureWatcher<PreflightReport> *preflight;
+    ProjectionModel *projectionModel;
 
-    QString parameters;
+    ConversionSpec spec;
     QString sourceProjInit;
 
     QList<QPair<QString, QString> > formatsListReadWrite;
@@ -76,6 +87,7 @@ private:
     QList<QPair<QString, QString> > databaseListReadOnly;
     QList<QPair<QString, QString> > webServiceList;
     QList<QPair<QString, QString> > projectionsList;
+    QStringList projectionFiles;
 
     QMenuBar *theMenu;
     QMenu *fileMenu;
@@ -88,6 +100,7 @@ private:
     QAction *mnuAbout;
 
     QProgressBar *progress;
+    QMap<int, QElapsedTimer> jobTimers;
 
     QWidget *thePanel;
     QVBoxLayout *theLayout;
@@ -112,6 +125,7 @@ private:
     QLabel *lblSourceEPSG;
     QHBoxLayout *lytSourceProj;
     QLineEdit *txtSourceProj;
+    QCompleter *cmpSourceProj;
     QLineEdit *txtSourceProjInit;
     QComboBox *cmbSourceProj;
 
@@ -138,6 +152,7 @@ private:
     QLabel *lblTargetProj;
     QHBoxLayout *lytTargetProj;
     QLineEdit *txtTargetProj;
+    QCompleter *cmpTargetProj;
     QComboBox *cmbTargetProj;
 
     QLabel *lblTargetSpat;
@@ -169,39 +184,55 @@ private:
 
     QHBoxLayout *lytExecute;
     QPushButton *btnConvert;
+    QPushButton *btnPause;
+    QPushButton *btnCancel;
+    QPushButton *btnClear;
+
+    QTableWidget *tabQueue;
 
     /**
          *	\fn void initData(void);
-         *	\brief Inits data
+         *	\brief Starts loading drivers, resources and projections, see evtStartupLoaded
          */
     void initData(void);
 
     /**
-     * \fn void readResources(const QFile file, QList<QPair<QString, QString> > &readonlyList, QList<QPair<QString, QString> > &readwriteList);
-     * \brief Read Resources
-     * \param file : resource file
-     * \param readonlyList : read file into readonly list
-     * \param readwriteList : read file into readwrite list
-     */
-    void readResources(QFile &file, QList<QPair<QString, QString> > &readonlyList, QList<QPair<QString, QString> > &readwriteList = QList<QPair<QString, QString> >());
+         *	\fn void setLoading(const bool loading);
+         *	\brief Disables source, target and convert while the startup data loads
+         *	       or the preflight checks run
+         */
+    void setLoading(const bool loading);
 
     /**
-         *	\fn void void initProjectionFiles(void);
-         *	\brief Inits projections
-         */
-    void initProjectionFiles(void);
+        * \fn QList<QPair<QString, QString> > readProjections(QStringList fileList);
+        * \brief Read projections of the files in the data folder
+        */
+    QList<QPair<QString, QString> > readProjections(const QStringList fileList);
 
     /**
-        * \fn void readProjections(QString filename);
-        * \brief Read projections
+        * \fn void reportMissingProjections(const QStringList fileList);
+        * \brief Tells the user which projection files were not found
         */
-    void readProjections(const QString filename);
+    void reportMissingProjections(const QStringList fileList);
 
     /**
-        * \fn initProjection();
+        * \fn initProjection(const QList<QPair<QString, QString> > projections);
         * \brief Add Projections to UI
         */
-    void initProjection();
+    void initProjection(const QList<QPair<QString, QString> > projections);
+
+    /**
+        * \fn int matchProjection(const QString text);
+        * \brief Looks up the combo box row of an EPSG code prefix or a name
+        * \returns row, 0 if nothing matches
+        */
+    int matchProjection(const QString text) const;
+
+    /**
+        * \fn void completeProjection(QCompleter *completer, const QString text);
+        * \brief Fills the completer with the ranked matches of the text
+        */
+    void completeProjection(QCompleter *completer, const QString text);
 
     /**
          *	\fn void initInterface(void);
@@ -247,15 +278,80 @@ private:
 
     /**
          *	\fn void updateParameters(void);
-         *	\brief Updates parameters
+         *	\brief Shows the command line of the spec
          */
     void updateParameters(void);
 
     /**
-         * \brief QString currentParameters(void);
-         * \return QString with parameters
+         *	\fn void updateSourceSpec(void);
+         *	\brief Copies source name, format and web service layers into the spec
          */
-    QString currentParameters(void) const;
+    void updateSourceSpec(void);
+
+    /**
+         *	\fn QString creationOption(QTableWidget *table);
+         *	\brief Reads NAME=VALUE from a creation option table and marks it if incomplete
+         */
+    QString creationOption(QTableWidget *table) const;
+
+    /**
+         *	\fn QStringList spatialFilter(void);
+         *	\brief Reads the four -spat values and marks the table if incomplete
+         */
+    QStringList spatialFilter(void) const;
+
+    /**
+         *	\fn QStringList selectedLayers(void);
+         *	\brief returns the web service layers or database tables selected
+         */
+    QStringList selectedLayers(void) const;
+
+    /**
+         *	\fn bool targetAllowsParallelLayers(void);
+         *	\brief returns true if several jobs may write layers into the target
+         */
+    bool targetAllowsParallelLayers(void) const;
+
+    /**
+         *	\fn QFileInfoList findBatchFiles(const QString folder, const QString extension);
+         *	\brief Finds source files below a folder, largest first
+         */
+    QFileInfoList findBatchFiles(const QString folder, const QString extension) const;
+
+    /**
+         *	\fn int enqueueJob(const QString name, const ConversionSpec job, const QList<int> dependencies);
+         *	\brief Adds a job to the queue and the queue panel
+         *	\returns job id
+         */
+    int enqueueJob(const QString name, const ConversionSpec job, const QList<int> dependencies = QList<int>());
+
+    /**
+         *	\fn bool enqueueShards(const QString sourcename, const QString targetname, const int shards, const GIntBig counted);
+         *	\brief Splits the opened source layer into FID ranges appended by
+         *	        parallel jobs to a table of a database server
+         *	\param counted : feature count from the preflight, -1 to take the
+         *	        one of the source catalog
+         *	\returns false if the source or target can not be sharded
+         */
+    bool enqueueShards(const QString sourcename, const QString targetname, const int shards, const GIntBig counted);
+
+    /**
+         *	\fn void initQueue(void);
+         *	\brief Applies queue settings from ogr2gui.ini
+         */
+    void initQueue(void);
+
+    /**
+         *	\fn int queueRow(const int id);
+         *	\brief returns the row of a job in the queue panel, -1 if none
+         */
+    int queueRow(const int id) const;
+
+    /**
+         *	\fn int selectedJob(void);
+         *	\brief returns the job selected in the queue panel, -1 if none
+         */
+    int selectedJob(void) const;
 
 
 private slots :
@@ -263,6 +359,7 @@ private slots :
     void evtMnuOgrHelp(void);
     void evtMnuGuiHelp(void);
     void evtMnuOgrAbout(void);
+    void evtStartupLoaded(StartupData data);
 
     void evtRadSourceFile(void);
     void evtRadSourceFolder(void);
@@ -271,9 +368,13 @@ private slots :
 
     void evtCmbSourceFormat(void);
     void evtTxtSourceName(void);
+    void evtSourceProbed(bool isOpen, QString layer, QString epsg, QString query);
     void evtBtnSourceName(void);
     void evtTxtSourceProj(void);
+    void evtTxtSourceProjEdited(QString text);
+    void evtCmpSourceProj(QString text);
     void evtCmbSourceProj(void);
+    void evtTxtSourceQuery(QString text);
 
     void evtRadTargetFile(void);
     void evtRadTargetFolder(void);
@@ -283,10 +384,23 @@ private slots :
     void evtTxtTargetName(void);
     void evtBtnTargetName(void);
     void evtTxtTargetProj(void);
-
-    void evtUpdateParameters(void);
+    void evtTxtTargetProjEdited(QString text);
+    void evtCmpTargetProj(QString text);
+    void evtCmbTargetProj(void);
+    void evtBtnTargetSpat(void);
+    void evtBtnTargetDSCO(void);
+    void evtBtnTargetLCO(void);
+    void evtChkTargetOptions(void);
+    void evtTxtOption(void);
 
     void evtBtnExecute(void);
+    void evtPreflightFinished(void);
+    void evtQueueJobChanged(int id);
+    void evtQueueJobProgress(int id, int percent, qlonglong features, qlonglong bytes);
+    void evtTabQueue(void);
+    void evtBtnPause(void);
+    void evtBtnCancel(void);
+    void evtBtnClear(void);
 
 public:
 
@@ -0,0 +1,176 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file conversionQueue.h
+ *	\brief Conversion Queue
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef CONVERSIONQUEUE_H
+#define CONVERSIONQUEUE_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QMap>
+#include "ogr2ogrJob.h"
+
+class ConversionQueue : public QObject {
+    Q_OBJECT
+public:
+    typedef enum { Queued, Running, Succeeded, Failed, Cancelled } State;
+
+    /**
+         *	\fn ConversionQueue(QObject * = 0);
+         *	\brief Constructor
+         */
+    ConversionQueue(QObject * = 0);
+
+    /**
+         *	\fn ~ConversionQueue(void);
+         *	\brief Destructor, cancels and waits for all jobs
+         */
+    ~ConversionQueue(void);
+
+    /**
+         *	\fn int enqueue(const QString name, const ConversionSpec spec, const QList<int> dependencies)
+         *	\brief Adds a job to the queue
+         *	\param name : display name
+         *	\param spec : ogr2ogr arguments
+         *	\param dependencies : jobs which must succeed before this one starts
+         *	\returns job id
+         */
+    int enqueue(const QString name, const ConversionSpec spec, const QList<int> dependencies = QList<int>());
+
+    /**
+         *	\fn void setMaxThreadCount(const int count)
+         *	\brief Sets the number of jobs running at the same time
+         */
+    void setMaxThreadCount(const int count);
+
+    /**
+         *	\fn void setSeparateProcess(const bool enable)
+         *	\brief Runs the following jobs in child processes
+         */
+    void setSeparateProcess(const bool enable);
+
+    /**
+         *	\fn void setMaxRetries(const int count)
+         *	\brief Sets how many times a failed job is queued again, jobs
+         *	        adding to an existing target are never retried
+         */
+    void setMaxRetries(const int count);
+
+    /**
+         *	\fn void cancel(const int id)
+         *	\brief Cancels a queued or running job
+         */
+    void cancel(const int id);
+
+    /**
+         *	\fn bool pause(const int id, const bool enable)
+         *	\brief Pauses or resumes a job
+         *	\returns true on success
+         */
+    bool pause(const int id, const bool enable);
+
+    /**
+         *	\fn void clearFinished(void)
+         *	\brief Removes jobs which left the thread pool
+         */
+    void clearFinished(void);
+
+    /**
+         *	\fn QList<int> getIds(void)
+         *	\brief returns job ids in queue order
+         */
+    QList<int> getIds(void) const;
+
+    /**
+         *	\fn bool isFinished(const int id)
+         *	\brief returns true if the job succeeded, failed or was cancelled
+         */
+    bool isFinished(const int id) const;
+
+    State getState(const int id) const;
+    QString getName(const int id) const;
+    QString getCommand(const int id) const;
+    int getProgress(const int id) const;
+    QString getMessage(const int id) const;
+
+signals:
+    /**
+         *	\fn void jobChanged(int id)
+         *	\brief Emitted when state, progress or message of a job change
+         */
+    void jobChanged(int id);
+
+    /**
+         *	\fn void jobProgress(int id, int percent, qlonglong features, qlonglong bytes)
+         *	\brief Emitted while a job translates
+         */
+    void jobProgress(int id, int percent, qlonglong features, qlonglong bytes);
+
+private slots:
+    void evtStarted(void);
+    void evtTranslated(bool success, QString error);
+    void evtProgress(int percent, qlonglong features, qlonglong bytes);
+
+private:
+    struct Entry {
+        Entry(void) : job(NULL), state(Queued), percent(0), attempts(0), retryable(false), held(false), cancelled(false), done(false) {}
+        Ogr2ogrJob *job;
+        QList<int> dependencies;
+        State state;
+        int percent;
+        int attempts;
+        bool retryable;
+        QString message;
+        bool held;
+        bool cancelled;
+        bool done;
+    };
+
+    QThreadPool pool;
+    QMap<int, Entry> jobs;
+    int nextId;
+    int maxRetries;
+    bool separateProcess;
+
+    /**
+         *	\fn int senderId(void)
+         *	\brief returns the id of the job emitting the current signal
+         */
+    int senderId(void) const;
+
+    /**
+         *	\fn void startReady(void)
+         *	\brief Starts held jobs whose dependencies succeeded, drops those
+         *	        whose dependencies did not
+         */
+    void startReady(void);
+};
+
+#endif
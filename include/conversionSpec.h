@@ -0,0 +1,100 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file conversionSpec.h
+ *	\brief Conversion Spec
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef CONVERSIONSPEC_H
+#define CONVERSIONSPEC_H
+
+#include <QString>
+#include <QStringList>
+
+struct ConversionSpec {
+    QString targetFormat;
+    QString target;
+    QString source;
+    QString inputFormat;
+    QString sourceSrs;
+    QString targetSrs;
+    QString sql;
+    QString where;
+    QString layerName;
+    bool overwrite;
+    bool append;
+    bool update;
+    bool skipFailures;
+    QStringList layers;
+    QStringList spatialFilter;
+    QString datasetCreationOption;
+    QString layerCreationOption;
+    QStringList extraArguments;
+
+    ConversionSpec(void) : overwrite(false), append(false), update(false), skipFailures(false) {}
+
+    /**
+         *	\fn QStringList options(void)
+         *	\returns ogr2ogr arguments without the datasources and -if, as
+         *	        GDALVectorTranslateOptionsNew takes them, unquoted
+         */
+    QStringList options(void) const;
+
+    /**
+         *	\fn QStringList arguments(void)
+         *	\returns ogr2ogr arguments without the program name, unquoted
+         */
+    QStringList arguments(void) const;
+
+    /**
+         *	\fn static ConversionSpec fromArguments(const QStringList list)
+         *	\brief Reads back the datasources of arguments(), the other
+         *	       options are kept as extra arguments
+         */
+    static ConversionSpec fromArguments(const QStringList list);
+
+    /**
+         *	\fn QString command(void)
+         *	\returns quoted command line for display and the log
+         */
+    QString command(void) const;
+
+    /**
+         *	\fn bool isIdempotent(void)
+         *	\returns true if running the job again cannot duplicate features,
+         *	        it creates or overwrites its target instead of adding to it
+         */
+    bool isIdempotent(void) const;
+
+    /**
+         *	\fn static QStringList tokenize(const QString text)
+         *	\brief Splits options typed by the user the way ogr2ogr does
+         */
+    static QStringList tokenize(const QString text);
+};
+
+#endif
@@ -0,0 +1,157 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file datasetCache.h
+ *	\brief Dataset Cache
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef DATASETCACHE_H
+#define DATASETCACHE_H
+
+#include "gdal.h"
+
+#include <string>
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QStringList>
+
+using std::string;
+
+class DatasetCache {
+public:
+    /**
+         *	\fn DatasetCache* getInstance(void);
+         *	\brief Get DatasetCache instance
+         */
+    static DatasetCache* getInstance(void);
+
+    /**
+         *	\fn ~DatasetCache(void);
+         *	\brief Destructor, closes the idle handles
+         */
+    ~DatasetCache(void);
+
+    /**
+         *	\fn GDALDatasetH acquire(const string name, const string driver);
+         *	\brief Opens a vector dataset read only, or reuses an idle handle
+         *	       of the same source. Handles of files are reused while none
+         *	       of their files changed, those of connection strings for a
+         *	       minute. The handle belongs to the caller until release.
+         *	\param name : file name or connection string
+         *	\param driver : driver tried first, all drivers are probed if it
+         *	       is empty or fails
+         *	\returns dataset handle, NULL on failure
+         */
+    GDALDatasetH acquire(const string name, const string driver = string());
+
+    /**
+         *	\fn void release(GDALDatasetH hDS);
+         *	\brief Gives back a handle from acquire, filters and reading
+         *	       position of its layers are reset
+         */
+    void release(GDALDatasetH hDS);
+
+    /**
+         *	\fn void invalidate(const string name);
+         *	\brief Closes the idle handles of a source about to be written,
+         *	       handles in use are closed on release
+         */
+    void invalidate(const string name);
+
+    /**
+         *	\fn void clear(void);
+         *	\brief Closes the idle handles
+         */
+    void clear(void);
+
+private:
+    struct Entry {
+        string key;
+        GDALDatasetH hDS;
+        QStringList files;
+        QByteArray state;
+        qint64 opened;
+        bool inUse;
+        bool stale;
+    };
+
+    static QMutex instanceMutex;
+    static DatasetCache* instance;
+    QMutex mutex;
+    QList<Entry> entries;
+    int capacity;
+
+    /**
+         *	\fn DatasetCache(void);
+         *	\brief Constructor
+         */
+    DatasetCache(void);
+    /**
+         *	\fn DatasetCache(const DatasetCache&);
+         *	\brief Copy constructor
+         */
+    DatasetCache(const DatasetCache&);
+    /**
+         *	\fn DatasetCache& operator=(const DatasetCache&);
+         *	\brief overwrite equal operator
+         */
+    DatasetCache& operator=(const DatasetCache&);
+
+    /**
+         *	\fn string normalize(const string name);
+         *	\brief returns the canonical path of files, the name itself otherwise
+         */
+    static string normalize(const string name);
+
+    /**
+         *	\fn QStringList files(const string name, GDALDatasetH hDS);
+         *	\brief returns the source and the files GDAL reads for it, sidecars
+         *	       included, empty for connection strings
+         */
+    static QStringList files(const string name, GDALDatasetH hDS);
+
+    /**
+         *	\fn QByteArray state(const QStringList files);
+         *	\brief returns modification time and size of the files
+         */
+    static QByteArray state(const QStringList files);
+
+    /**
+         *	\fn bool isValid(const Entry &entry);
+         *	\brief returns true if the handle may be reused
+         */
+    static bool isValid(const Entry &entry);
+
+    /**
+         *	\fn void evict(void);
+         *	\brief Closes the least recently used idle handles over capacity
+         */
+    void evict(void);
+};
+
+#endif
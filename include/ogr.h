@@ -35,8 +35,10 @@
 
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
-#include "utils.h"
-#include "ogr2ogrThread.h"
+#include "datasetCache.h"
+#include "srsCache.h"
+#include "transformBatch.h"
+#include "sourceCatalog.h"
 
 #include <string>
 #include <QStringList>
@@ -50,10 +52,6 @@ class Ogr
 {
 private :
 
-    Ogr2ogrThread *ogr2ogr;
-
-    QProcess *process;
-
     OGRSFDriverH formatDriver;
 
     OGRDataSourceH sourceData;
@@ -65,6 +63,10 @@ private :
 
     OGRSpatialReferenceH sourceSRS;
     OGRSpatialReferenceH targetSRS;
+    int targetEPSG;
+
+    OGRCoordinateTransformationH transformation;
+    static const int batchSize = 256;
 
     OGRFeatureDefnH sourceLayerDefn;
     OGRwkbGeometryType sourceLayerGeom;
@@ -72,6 +74,7 @@ private :
     OGRGeometryH sourceGeom;
 
     string sourceName;
+    string sourceFormat;
     string layerName;
     string sourceLayerName;
     string targetName;
@@ -87,11 +90,27 @@ private :
          */
     bool Error(OGRErr e, string &s);
 
+    /**
+         *	\fn bool testFeatures(QList<OGRFeatureH> &features);
+         *	\brief Transforms the feature geometries to the target projection
+         *	        in one batch and destroys the features
+         *	\returns true on success
+         */
+    bool testFeatures(QList<OGRFeatureH> &features);
+
+    /**
+         *	\fn bool testFeatureSample(const int sample);
+         *	\brief Transforms the extent corners and the sample with the
+         *	        acquired transformation, see testFeatureProjection
+         *	\returns true on success
+         */
+    bool testFeatureSample(const int sample);
+
 public:
 
     /**
          *	\fn Ogr(void);
-         *	\brief Constructor
+         *	\brief Constructor, the drivers must have been registered with OGRRegisterAll
          */
     Ogr(void);
 
@@ -101,15 +120,6 @@ public:
          */
     ~Ogr(void);
 
-    /**
-     * \fn bool openOgr2ogr(QString command, QPushButton *btnExecute)
-     * \brief Open ogr2ogr command line
-     * \param command : command with arguments
-     * \param btnExecute : execute button
-     * \return true on success
-     */
-    bool openOgr2ogr(QString command, QPushButton *btnExecute);
-
     /**
          * \fn bool openWFS(QStringList &fileList)
          * \brief Open WFS data
@@ -147,7 +157,46 @@ public:
          *	\brief Closes source data
          *	\returns true on success
          */
-    bool closeSource(void) const;
+    bool closeSource(void);
+
+    /**
+         *	\fn void setSourceFormat(const string format);
+         *	\brief Sets the driver tried first when opening sources
+         *	\param format : driver name, empty to probe all drivers
+         */
+    void setSourceFormat(const string format);
+
+    /**
+         *	\fn int getSourceLayerCount(void);
+         *	\returns number of layers of the opened source, 0 if none
+         */
+    int getSourceLayerCount(void) const;
+
+    /**
+         *	\fn string getSourceLayerName(void);
+         *	\returns name of the opened source layer
+         */
+    string getSourceLayerName(void) const;
+
+    /**
+         *	\fn GIntBig getSourceFeatureCount(void);
+         *	\returns feature count of the opened source layer, -1 if unknown
+         */
+    GIntBig getSourceFeatureCount(void) const;
+
+    /**
+         *	\fn QList<LayerInfo> getSourceLayers(void);
+         *	\brief Describes every layer of the opened source without
+         *	        reading its features
+         *	\returns layers of the source
+         */
+    QList<LayerInfo> getSourceLayers(void) const;
+
+    /**
+         *	\fn QStringList getSourceFiles(void);
+         *	\returns files GDAL reads for the opened source, sidecars included
+         */
+    QStringList getSourceFiles(void) const;
 
     /**
          *	\fn bool openDriver(string drivername, string error = 0);
@@ -158,10 +207,12 @@ public:
     bool openDriver(const string drivername);
 
     /**
-     *	\fn bool testFeatureProjection(void);
-     *	\brief Test feature projections
+     *	\fn bool testFeatureProjection(const int sample);
+     *	\brief Test feature projections on the extent corners and a sample
+     *	       of features
+     *	\param sample : number of features to transform, all if 0
      */
-    bool testFeatureProjection(void);
+    bool testFeatureProjection(const int sample);
 
     /**
      * \fn bool testSpatialReference(int projection)
@@ -173,7 +224,9 @@ public:
 
     /**
      * \fn bool testExecuteSQL(string query)
-     * \brief Execute sql query
+     * \brief Validates the sql query without reading its result. Queries
+     *        for database drivers are wrapped in a LIMIT 0 select, OGR SQL
+     *        only builds the result layer definition.
      * \param query : sql query
      * \return true on success
      */
@@ -0,0 +1,175 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file ogr2ogrEngine.h
+ *	\brief In-process ogr2ogr
+ *	\author David Tran
+ *	\version 0.8
+ */
+
+#ifndef OGR2OGRENGINE_H
+#define OGR2OGRENGINE_H
+
+#include "gdal_utils.h"
+#include "cpl_string.h"
+#include "conversionSpec.h"
+
+#include <string>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QWaitCondition>
+
+using std::string;
+
+class Ogr2ogrEngine {
+private:
+    string error;
+    string target;
+    GIntBig featureCount;
+    GDALProgressFunc pfnProgress;
+    void *pProgressArg;
+    GDALDatasetH hTransactionDS;
+    bool interrupted;
+
+    QAtomicInt cancelled;
+    QAtomicInt paused;
+    QMutex pauseMutex;
+    QWaitCondition pauseCondition;
+
+    /**
+         *	\fn int static CPL_STDCALL progress(double, const char *, void *);
+         *	\brief Checks the cancel/pause token, then calls the user progress
+         */
+    static int CPL_STDCALL progress(double dfComplete, const char *pszMessage, void *pProgressArg);
+
+    /**
+         *	\fn bool static proceed(void *pContinueArg);
+         *	\brief Blocks while paused, on cancel rolls back the transaction
+         *	        open on the target, see TransformContinueFunc
+         *	\returns false once cancelled
+         */
+    static bool proceed(void *pContinueArg);
+
+    /**
+         *	\fn void static CPL_STDCALL errorHandler(CPLErr, CPLErrorNum, const char *);
+         *	\brief Collects GDAL messages of the running translation
+         */
+    static void CPL_STDCALL errorHandler(CPLErr eErr, CPLErrorNum nErrorNum, const char *pszMessage);
+
+    /**
+         *	\fn int static batchedTarget(char **papszArguments);
+         *	\brief returns the EPSG code of -t_srs if the features can be
+         *	        reprojected in batches before ogr2ogr sees them, 0 if an
+         *	        option works on the source coordinates or the code is not
+         *	        a plain EPSG code
+         */
+    static int batchedTarget(char **papszArguments);
+
+    /**
+         *	\fn GIntBig static countFeatures(GDALDatasetH hDS, const QStringList layers);
+         *	\brief returns the fast feature count of the translated layers,
+         *	        all of them if none are named, -1 if unknown
+         */
+    static GIntBig countFeatures(GDALDatasetH hDS, const QStringList layers);
+
+public:
+    /**
+         *	\fn Ogr2ogrEngine(void);
+         *	\brief Constructor
+         */
+    Ogr2ogrEngine(void);
+
+    /**
+         *	\fn ~Ogr2ogrEngine(void);
+         *	\brief Destructor
+         */
+    ~Ogr2ogrEngine(void);
+
+    /**
+     * \fn bool translate(const ConversionSpec &spec)
+     * \brief Runs GDALVectorTranslate in the calling thread
+     * \param spec : ogr2ogr arguments
+     * \return true on success
+     */
+    bool translate(const ConversionSpec &spec);
+
+    /**
+     * \fn void setProgress(GDALProgressFunc pfnProgress, void *pProgressArg)
+     * \brief Progress callback passed to GDALVectorTranslateOptionsSetProgress
+     * \param pfnProgress : callback, NULL for none
+     * \param pProgressArg : callback argument
+     */
+    void setProgress(GDALProgressFunc pfnProgress, void *pProgressArg);
+
+    /**
+     * \fn void cancel(void)
+     * \brief Stops the translation at the next feature read, the open
+     *        transaction is rolled back and a newly created target removed.
+     *        A translation which already read its last feature succeeds
+     */
+    void cancel(void);
+
+    /**
+     * \fn void pause(void)
+     * \brief Blocks the translation at the next feature read
+     */
+    void pause(void);
+
+    /**
+     * \fn void resume(void)
+     * \brief Resumes a paused translation
+     */
+    void resume(void);
+
+    /**
+     * \fn bool isCancelled(void)
+     * \return true if cancel was requested
+     */
+    bool isCancelled(void) const;
+
+    /**
+     * \fn GIntBig getFeatureCount(void)
+     * \brief Fast feature count of the translated source layers, -1 if
+     *        unknown or filtered by -where, -spat, -fid, -sql or clipping
+     * \return feature count
+     */
+    GIntBig getFeatureCount(void) const;
+
+    /**
+     * \fn string getTarget(void)
+     * \brief Target datasource of the running translation
+     * \return target name
+     */
+    string getTarget(void) const;
+
+    /**
+     * \fn string getError(void)
+     * \brief GDAL messages of the last translation
+     * \return error text
+     */
+    string getError(void) const;
+};
+
+#endif
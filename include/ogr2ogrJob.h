@@ -0,0 +1,162 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file ogr2ogrJob.h
+ *	\brief ogr2ogr Job
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef OGR2OGRJOB_H
+#define OGR2OGRJOB_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QMutex>
+#include <QFile>
+#include <QTextStream>
+#include <QDir>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include "ogr2ogrEngine.h"
+#include "ogr2ogrProcess.h"
+#include "conversionSpec.h"
+
+class Ogr2ogrJob : public QObject, public QRunnable {
+    Q_OBJECT
+public:
+    /**
+         *	\fn Ogr2ogrJob(const int, const QString, const ConversionSpec, const bool)
+         *	\brief Constructor
+         *	\param id : job id in the queue
+         *	\param name : display name
+         *	\param spec : ogr2ogr arguments
+         *	\param separateProcess : run ogr2ogr in a child process
+         */
+    Ogr2ogrJob(const int, const QString, const ConversionSpec, const bool);
+
+    /**
+         *	\fn ~Ogr2ogrJob(void);
+         *	\brief Destructor
+         */
+    ~Ogr2ogrJob(void);
+
+    /**
+         *	\fn void run(void);
+         *	\brief Runs the translation in a thread of the pool
+         */
+    void run(void);
+
+    /**
+         *	\fn void cancel(void);
+         *	\brief Cancels the translation, see Ogr2ogrEngine::cancel
+         */
+    void cancel(void);
+
+    /**
+         *	\fn bool pause(bool enable);
+         *	\brief Pauses or resumes the translation
+         *	\returns true on success
+         */
+    bool pause(const bool enable);
+
+    /**
+         *	\fn int getId(void)
+         *	\brief returns job id
+         */
+    int getId(void) const;
+
+    /**
+         *	\fn QString getName(void)
+         *	\brief returns display name
+         */
+    QString getName(void) const;
+
+    /**
+         *	\fn QString getCommand(void)
+         *	\brief returns ogr2ogr command line, for display
+         */
+    QString getCommand(void) const;
+
+signals:
+    /**
+         *	\fn void started(void)
+         *	\brief Emitted from the worker thread when the job leaves the queue
+         */
+    void started(void);
+
+    /**
+         *	\fn void translated(bool success, QString error)
+         *	\brief Emitted from the worker thread when the translation ends
+         */
+    void translated(bool success, QString error);
+
+    /**
+         *	\fn void progressChanged(int percent, qlonglong features, qlonglong bytes)
+         *	\brief Emitted from the worker thread while translating
+         *	\param percent : progress in percent
+         *	\param features : features written so far, -1 if unknown
+         *	\param bytes : size of the target so far, -1 if unknown
+         */
+    void progressChanged(int percent, qlonglong features, qlonglong bytes);
+
+private slots:
+    void evtProcessTranslated(bool success, QString error);
+
+private:
+    const int id;
+    const QString name;
+    const ConversionSpec spec;
+    const QString command;
+    const bool separateProcess;
+    Ogr2ogrEngine engine;
+    Ogr2ogrProcess *process;
+    QMutex processMutex;
+    QElapsedTimer timer;
+    int percent;
+    bool processResult;
+    QString processError;
+
+    static QMutex logMutex;
+
+    /**
+         *	\fn int static CPL_STDCALL progress(double, const char *, void *);
+         *	\brief GDALProgressFunc forwarding to progressChanged
+         */
+    static int CPL_STDCALL progress(double dfComplete, const char *pszMessage, void *pProgressArg);
+
+    /**
+         *	\fn bool runProcess(QString &error);
+         *	\brief Runs Ogr2ogrProcess with a local event loop
+         */
+    bool runProcess(QString &error);
+
+    /**
+         *	\fn void appendLog(const QByteArray &text);
+         *	\brief Appends the transcript of a job to ogr2ogr.log
+         */
+    static void appendLog(const QByteArray &text);
+};
+
+#endif
@@ -0,0 +1,136 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file ogr2ogrProcess.h
+ *	\brief ogr2ogr Process
+ *	\author David Tran
+ *	\version 0.8
+ */
+
+#ifndef OGR2OGRPROCESS_H
+#define OGR2OGRPROCESS_H
+
+#include <QObject>
+#include <QProcess>
+#include <QStringList>
+#include "conversionSpec.h"
+
+class Ogr2ogrProcess : public QObject {
+    Q_OBJECT
+public:
+    /**
+         *	\fn Ogr2ogrProcess(const ConversionSpec, QObject * = 0)
+         *	\brief Constructor
+         *	\param spec : ogr2ogr arguments
+         */
+    Ogr2ogrProcess(const ConversionSpec, QObject * = 0);
+
+    /**
+         *	\fn ~Ogr2ogrProcess(void);
+         *	\brief Destructor
+         */
+    ~Ogr2ogrProcess(void);
+
+    /**
+         *	\fn void start(void);
+         *	\brief Starts the child process and returns immediately
+         */
+    void start(void);
+
+    /**
+         *	\fn bool isRunning(void);
+         *	\brief returns true while the child process runs
+         */
+    bool isRunning(void) const;
+
+    /**
+         *	\fn QByteArray getTranscript(void);
+         *	\brief returns the output of the child process, written to the
+         *	        log by Ogr2ogrJob once it ended
+         */
+    QByteArray getTranscript(void) const;
+
+    /**
+         *	\fn bool pause(bool enable);
+         *	\brief Stops or continues the child process, POSIX only
+         *	\returns true on success
+         */
+    bool pause(const bool enable);
+
+public slots:
+    /**
+         *	\fn void cancel(void);
+         *	\brief Terminates the child process, a target it created is removed
+         */
+    void cancel(void);
+
+signals:
+    /**
+         *	\fn void translated(bool success, QString error)
+         *	\brief Emitted when the child process ends
+         */
+    void translated(bool success, QString error);
+
+    /**
+         *	\fn void progressChanged(int percent, qlonglong features, qlonglong bytes)
+         *	\brief Emitted while ogr2ogr prints its -progress output
+         */
+    void progressChanged(int percent, qlonglong features, qlonglong bytes);
+
+private slots:
+    void evtReadyRead(void);
+    void evtFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void evtError(QProcess::ProcessError processError);
+
+private:
+    const ConversionSpec spec;
+    QProcess process;
+    QByteArray transcript;
+    QString error;
+    QByteArray output;
+    bool created;
+    bool cancelled;
+
+    /**
+         *	\fn QString program(void);
+         *	\brief ogr2ogr from PATH, or this binary in command line mode
+         */
+    static QString program(void);
+
+    /**
+         *	\fn QStringList arguments(void);
+         *	\brief Arguments of the spec with -progress and without -if
+         */
+    QStringList arguments(void) const;
+
+    /**
+         *	\fn void removeTarget(void);
+         *	\brief Deletes the target of a cancelled run if it did not exist
+         *	        before the job
+         */
+    void removeTarget(void);
+};
+
+#endif
@@ -0,0 +1,113 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file preflight.h
+ *	\brief Preflight
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef PREFLIGHT_H
+#define PREFLIGHT_H
+
+#include "ogr.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+struct PreflightRequest {
+    QString source;
+    QString sourceFormat;
+    QStringList layers;
+    QString query;
+    QString targetFormat;
+    int targetProjection;
+    bool testFeatures;
+    int samples;
+    bool countFeatures;
+
+    PreflightRequest(void) : targetProjection(0), testFeatures(false), samples(0), countFeatures(false) {}
+};
+
+struct PreflightReport {
+    bool sourceOpened;
+    bool queryValid;
+    bool driverFound;
+    bool projectionValid;
+    bool featuresTransformed;
+    GIntBig features;
+
+    PreflightReport(void) : sourceOpened(false), queryValid(true), driverFound(false), projectionValid(true), featuresTransformed(true), features(-1) {}
+};
+
+class Preflight {
+public:
+    /**
+         *	\fn static PreflightReport run(Ogr *ogr, const PreflightRequest request);
+         *	\brief Checks source, query, target driver and projection before
+         *	       a conversion. The driver and the projection are checked by
+         *	       QtConcurrent tasks while the source is opened, the feature
+         *	       test needs both source and projection and runs last.
+         *	       With countFeatures the opened layer is counted as well.
+         *	       Results are reused while source file, layers, query and
+         *	       target are unchanged, only the source is opened again.
+         *	       Those of connection strings are reused for five minutes.
+         *	\param ogr : left with the source open for the caller
+         *	\param request : what to check
+         *	\returns results of all checks
+         */
+    static PreflightReport run(Ogr *ogr, const PreflightRequest request);
+
+private:
+    struct CacheEntry {
+        PreflightReport report;
+        qint64 stored;
+        bool connection;
+    };
+
+    static QMutex cacheMutex;
+    static QHash<QString, CacheEntry> cache;
+
+    /**
+         *	\fn static QString cacheKey(const PreflightRequest &request, bool &connection);
+         *	\returns key of the request, including modification time and size of a source file
+         *	\param &connection : true if the source is no file, its entry expires
+         */
+    static QString cacheKey(const PreflightRequest &request, bool &connection);
+
+    /**
+         *	\fn static bool checkDriver(const QString format);
+         */
+    static bool checkDriver(const QString format);
+
+    /**
+         *	\fn static bool checkProjection(const int projection);
+         */
+    static bool checkProjection(const int projection);
+};
+
+#endif
@@ -0,0 +1,78 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file projectionIndex.h
+ *	\brief Projection Index
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef PROJECTIONINDEX_H
+#define PROJECTIONINDEX_H
+
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+class ProjectionIndex {
+public:
+    /**
+         *	\fn bool load(const QStringList files, QList<QPair<QString, QString> > &projections);
+         *	\brief Reads the projections of the CSV files sorted by EPSG code,
+         *	       from the binary index if it was built from the same files
+         *	\param files : CSV file paths
+         *	\param &projections : EPSG codes and names
+         *	\returns true if the index was used
+         */
+    static bool load(const QStringList files, QList<QPair<QString, QString> > &projections);
+
+private:
+    /**
+         *	\fn QByteArray fingerprint(const QStringList files);
+         *	\brief Hash of the paths, sizes and modification times of the files
+         */
+    static QByteArray fingerprint(const QStringList files);
+
+    /**
+         *	\fn void parse(const QString file, QList<QPair<int, QString> > &projections);
+         *	\brief Reads code and name of the projections of a CSV file
+         */
+    static void parse(const QString file, QList<QPair<int, QString> > &projections);
+
+    /**
+         *	\fn bool read(const QByteArray fingerprint, QList<QPair<QString, QString> > &projections);
+         *	\brief Maps the index file and reads it if it matches the fingerprint
+         */
+    static bool read(const QByteArray fingerprint, QList<QPair<QString, QString> > &projections);
+
+    /**
+         *	\fn void write(const QByteArray fingerprint, const QList<QPair<int, QString> > &projections);
+         *	\brief Writes the index file
+         */
+    static void write(const QByteArray fingerprint, const QList<QPair<int, QString> > &projections);
+};
+
+#endif
@@ -0,0 +1,88 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file projectionModel.h
+ *	\brief Projection Model
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef PROJECTIONMODEL_H
+#define PROJECTIONMODEL_H
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include "projectionSearch.h"
+
+class ProjectionModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    /**
+         *	\fn ProjectionModel(QList<QPair<QString, QString> > *, QObject * = 0);
+         *	\brief Constructor
+         *	\param projections : EPSG codes and names, owned by the caller and
+         *	       only changed through setProjections
+         */
+    ProjectionModel(QList<QPair<QString, QString> > *projections, QObject * = 0);
+
+    /**
+         *	\fn int rowCount(const QModelIndex &parent)
+         *	\returns number of projections
+         */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+
+    /**
+         *	\fn QVariant data(const QModelIndex &index, int role)
+         *	\returns "code name" of the projection, built when the view asks
+         */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+    /**
+         *	\fn void setProjections(const QList<QPair<QString, QString> > &list)
+         *	\brief Replaces the projection list inside a model reset, puts the
+         *	       empty "no projection" row first and rebuilds the lookup index
+         */
+    void setProjections(const QList<QPair<QString, QString> > &list);
+
+    /**
+         *	\fn int indexOf(const QString code)
+         *	\returns row of the EPSG code, -1 if unknown
+         */
+    int indexOf(const QString code) const;
+
+    /**
+         *	\fn const ProjectionSearch &getSearch(void)
+         *	\returns code and name index of the current list
+         */
+    const ProjectionSearch &getSearch(void) const;
+
+private:
+    QList<QPair<QString, QString> > *projections;
+    ProjectionSearch search;
+};
+
+#endif
@@ -0,0 +1,107 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file projectionSearch.h
+ *	\brief Projection Search
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef PROJECTIONSEARCH_H
+#define PROJECTIONSEARCH_H
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+class ProjectionSearch {
+public:
+    /**
+         *	\fn ProjectionSearch(void);
+         *	\brief Constructor
+         */
+    ProjectionSearch(void);
+
+    /**
+         *	\fn void build(const QList<QPair<QString, QString> > &projections);
+         *	\brief Indexes codes and names, rows are positions in the list
+         */
+    void build(const QList<QPair<QString, QString> > &projections);
+
+    /**
+         *	\fn int find(const QString code);
+         *	\returns row of the exact EPSG code, -1 if none
+         */
+    int find(const QString code) const;
+
+    /**
+         *	\fn int findPrefix(const QString prefix);
+         *	\returns row of the smallest EPSG code starting with the digits, -1 if none
+         */
+    int findPrefix(const QString prefix) const;
+
+    /**
+         *	\fn QList<int> search(const QString text, const int limit);
+         *	\brief Ranked matches, codes for digits and names otherwise
+         *	\param text : EPSG code prefix or part of a name
+         *	\param limit : maximum number of rows
+         *	\returns rows, best match first
+         */
+    QList<int> search(const QString text, const int limit) const;
+
+private:
+    struct Node {
+        int children[10];
+        int first;
+        Node(void) : first(-1) { for(int i = 0; i < 10; ++i) children[i] = -1; }
+    };
+
+    QHash<QString, int> codes;
+    QVector<Node> trie;
+    QHash<quint64, QVector<int> > trigrams;
+    QVector<QString> names;
+
+    /**
+         *	\fn int node(const QString prefix);
+         *	\returns trie node of the digits, -1 if none
+         */
+    int node(const QString prefix) const;
+
+    /**
+         *	\fn void collect(const int node, const int limit, QList<int> &rows);
+         *	\brief Appends the rows below a trie node in numeric order of
+         *	        their codes, until there are limit rows
+         */
+    void collect(const int node, const int limit, QList<int> &rows) const;
+
+    /**
+         *	\fn quint64 trigram(const QString &text, const int position);
+         */
+    static quint64 trigram(const QString &text, const int position);
+};
+
+#endif
@@ -34,6 +34,7 @@
 
 #include <QtWidgets>
 #include "i18n.h"
+#include "startupTimer.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -41,7 +42,7 @@ class Settings : public QDialog {
     Q_OBJECT
 private:
     QString language;
-    QVariant gcs, pcs, gcsoverride, pcsoverride;
+    QVariant gcs, pcs, gcsoverride, pcsoverride, process, threads, splitlayers, batch, retries, shards, samples;
 
     QVBoxLayout *theLayout;
     QHBoxLayout *lytDialog;
@@ -56,6 +57,19 @@ private:
     QCheckBox *ckbPcs;
     QCheckBox *ckbGcsOverride;
     QCheckBox *ckbPcsOverride;
+    QLabel *lblConvert;
+    QGridLayout *lytConvert;
+    QCheckBox *ckbProcess;
+    QCheckBox *ckbSplitLayers;
+    QCheckBox *ckbBatch;
+    QLabel *lblRetries;
+    QSpinBox *spbRetries;
+    QLabel *lblShards;
+    QSpinBox *spbShards;
+    QLabel *lblSamples;
+    QSpinBox *spbSamples;
+    QLabel *lblThreads;
+    QSpinBox *spbThreads;
 
     QList<QPair<QString, QString> > languageList;
 
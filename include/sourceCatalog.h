@@ -0,0 +1,106 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file sourceCatalog.h
+ *	\brief Source Catalog
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef SOURCECATALOG_H
+#define SOURCECATALOG_H
+
+#include <QList>
+#include <QString>
+#include <QtSql>
+
+struct LayerInfo {
+    QString name;
+    QString geometry;
+    QString epsg;
+    QString fields;
+    double minX, minY, maxX, maxY;
+    qlonglong features;
+
+    LayerInfo(void) : minX(0), minY(0), maxX(0), maxY(0), features(-1) {}
+};
+
+class SourceCatalog {
+public:
+    /**
+         *	\fn bool lookup(const QString source, QList<LayerInfo> &layers);
+         *	\brief Reads the layers of a source from the catalog
+         *	\param source : file name or connection string
+         *	\param &layers : layers of the source
+         *	\returns true if the source is known and none of its files
+         *	         changed, connection strings are known for five minutes
+         */
+    static bool lookup(const QString source, QList<LayerInfo> &layers);
+
+    /**
+         *	\fn void store(const QString source, const QList<LayerInfo> &layers, const QStringList files);
+         *	\brief Writes the layers of a source to the catalog
+         *	\param files : files read for the source, see Ogr::getSourceFiles,
+         *	       checked by lookup as well as the source
+         */
+    static void store(const QString source, const QList<LayerInfo> &layers, const QStringList files = QStringList());
+
+    /**
+         *	\fn QString fingerprint(const QString source, qlonglong &mtime, qlonglong &size);
+         *	\brief Catalog key of a source, a hash so connection strings and
+         *	       their passwords are not stored
+         *	\param &mtime : modification time of files, 0 otherwise
+         *	\param &size : size of files, -1 otherwise
+         */
+    static QString fingerprint(const QString source, qlonglong &mtime, qlonglong &size);
+
+private:
+    /**
+         *	\class Connection
+         *	\brief Catalog connection of one call, removed when it goes out
+         *	        of scope. Pool threads expire and their ids are reused,
+         *	        connections can thus not be kept per thread.
+         */
+    class Connection {
+    public:
+        Connection(void);
+        ~Connection(void);
+        QSqlDatabase database(void) const;
+    private:
+        QString name;
+        Connection(const Connection&);
+        Connection& operator=(const Connection&);
+    };
+
+    static QAtomicInt connections;
+
+    /**
+         *	\fn void state(const QStringList files, qlonglong &mtime, qlonglong &size);
+         *	\brief Latest modification time and total size of the files
+         */
+    static void state(const QStringList files, qlonglong &mtime, qlonglong &size);
+};
+
+#endif
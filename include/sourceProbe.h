@@ -0,0 +1,108 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file sourceProbe.h
+ *	\brief Source Probe
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef SOURCEPROBE_H
+#define SOURCEPROBE_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QTimer>
+
+class SourceProbe : public QObject {
+    Q_OBJECT
+public:
+    /**
+         *	\fn SourceProbe(QObject * = 0);
+         *	\brief Constructor
+         */
+    SourceProbe(QObject * = 0);
+
+    /**
+         *	\fn ~SourceProbe(void);
+         *	\brief Destructor, waits for running probes
+         */
+    ~SourceProbe(void);
+
+    /**
+         *	\fn void probe(const QString name, const QString format)
+         *	\brief Opens the source in a worker thread once the name stops
+         *	       changing, results of older names are dropped
+         *	\param name : source name or connection string
+         *	\param format : driver tried first
+         */
+    void probe(const QString name, const QString format);
+
+signals:
+    /**
+         *	\fn void probed(bool success, QString layer, QString epsg, QString query)
+         *	\brief Emitted with the result of the latest probe
+         */
+    void probed(bool success, QString layer, QString epsg, QString query);
+
+private slots:
+    void evtTimeout(void);
+    void evtProbed(int generation, bool success, QString layer, QString epsg, QString query);
+
+private:
+    QThreadPool pool;
+    QTimer timer;
+    QString name;
+    QString format;
+    int generation;
+};
+
+class SourceProbeTask : public QRunnable {
+public:
+    /**
+         *	\fn SourceProbeTask(SourceProbe *, const int, const QString, const QString)
+         *	\brief Constructor
+         *	\param probe : receiver of the result
+         *	\param generation : probe generation
+         *	\param name : source name
+         *	\param format : driver tried first
+         */
+    SourceProbeTask(SourceProbe *probe, const int generation, const QString name, const QString format);
+
+    /**
+         *	\fn void run(void);
+         *	\brief Opens the source and posts the result to the probe
+         */
+    void run(void);
+
+private:
+    SourceProbe *probe;
+    const int generation;
+    const QString name;
+    const QString format;
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ *	\file srsCache.h
+ *	\brief Spatial Reference Cache
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef SRSCACHE_H
+#define SRSCACHE_H
+
+#include "ogr_srs_api.h"
+
+#include <string>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+using std::string;
+
+class SrsCache {
+public:
+    /**
+         *	\fn SrsCache* getInstance(void);
+         *	\brief Get SrsCache instance
+         */
+    static SrsCache* getInstance(void);
+
+    /**
+         *	\fn ~SrsCache(void);
+         *	\brief Destructor, releases the spatial references and the idle
+         *	       transformations
+         */
+    ~SrsCache(void);
+
+    /**
+         *	\fn OGRSpatialReferenceH get(const int epsg, OGRErr *eErr);
+         *	\brief Imports an EPSG code once, failures are remembered too.
+         *	       The handle belongs to the cache and is shared between
+         *	       threads, it must only be read.
+         *	\param epsg : EPSG code
+         *	\param eErr : import error, may be NULL
+         *	\returns spatial reference, NULL on failure
+         */
+    OGRSpatialReferenceH get(const int epsg, OGRErr *eErr = NULL);
+
+    /**
+         *	\fn string wkt(const int epsg);
+         *	\brief returns the WKT of an EPSG code, empty on failure
+         */
+    string wkt(const int epsg);
+
+    /**
+         *	\fn OGRCoordinateTransformationH acquire(OGRSpatialReferenceH source, const int target);
+         *	\brief Creates a transformation, or reuses an idle one of the
+         *	       same pair. Transformations are not thread safe, the
+         *	       handle belongs to the caller until release.
+         *	\param source : source spatial reference
+         *	\param target : target EPSG code
+         *	\returns transformation, NULL on failure
+         */
+    OGRCoordinateTransformationH acquire(OGRSpatialReferenceH source, const int target);
+
+    /**
+         *	\fn void release(OGRCoordinateTransformationH hCT);
+         *	\brief Gives back a transformation from acquire
+         */
+    void release(OGRCoordinateTransformationH hCT);
+
+    /**
+         *	\fn void clear(void);
+         *	\brief Destroys the idle transformations
+         */
+    void clear(void);
+
+private:
+    struct Reference {
+        OGRSpatialReferenceH hSRS;
+        string wkt;
+        OGRErr eErr;
+    };
+
+    struct Transformation {
+        string key;
+        OGRCoordinateTransformationH hCT;
+        bool inUse;
+    };
+
+    static QMutex instanceMutex;
+    static SrsCache* instance;
+    QMutex mutex;
+    QHash<int, Reference> references;
+    QList<Transformation> transformations;
+    int capacity;
+
+    /**
+         *	\fn SrsCache(void);
+         *	\brief Constructor
+         */
+    SrsCache(void);
+    /**
+         *	\fn SrsCache(const SrsCache&);
+         *	\brief Copy constructor
+         */
+    SrsCache(const SrsCache&);
+    /**
+         *	\fn SrsCache& operator=(const SrsCache&);
+         *	\brief overwrite equal operator
+         */
+    SrsCache& operator=(const SrsCache&);
+
+    /**
+         *	\fn Reference import(const int epsg);
+         *	\brief returns the cached reference of an EPSG code, imports it
+         *	       on the first call
+         */
+    Reference import(const int epsg);
+
+    /**
+         *	\fn void evict(void);
+         *	\brief Destroys the least recently used idle transformations
+         *	       over capacity
+         */
+    void evict(void);
+};
+
+#endif
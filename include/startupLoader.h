@@ -0,0 +1,127 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file startupLoader.h
+ *	\brief Startup Loader
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef STARTUPLOADER_H
+#define STARTUPLOADER_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QFile>
+#include <QList>
+#include <QPair>
+#include <QStringList>
+#include <QMetaType>
+
+struct StartupData {
+    QList<QPair<QString, QString> > formatsReadOnly;
+    QList<QPair<QString, QString> > formatsReadWrite;
+    QList<QPair<QString, QString> > databasesReadOnly;
+    QList<QPair<QString, QString> > databasesReadWrite;
+    QList<QPair<QString, QString> > webServices;
+    QList<QPair<QString, QString> > projections;
+    QStringList missingProjectionFiles;
+};
+
+Q_DECLARE_METATYPE(StartupData)
+
+class StartupLoader : public QObject {
+    Q_OBJECT
+public:
+    /**
+         *	\fn StartupLoader(QObject * = 0);
+         *	\brief Constructor
+         */
+    StartupLoader(QObject * = 0);
+
+    /**
+         *	\fn ~StartupLoader(void);
+         *	\brief Destructor, waits for the running load
+         */
+    ~StartupLoader(void);
+
+    /**
+         *	\fn void load(const QStringList projectionFiles)
+         *	\brief Registers the drivers and reads resources and projections
+         *	       in a worker thread, see loaded
+         *	\param projectionFiles : projection files in the data folder
+         */
+    void load(const QStringList projectionFiles);
+
+    /**
+         *	\fn static void readResources(QFile &file, QList<QPair<QString, QString> > &readonlyList, QList<QPair<QString, QString> > &readwriteList);
+         *	\brief Read Resources
+         *	\param file : resource file
+         *	\param readonlyList : read file into readonly list
+         *	\param readwriteList : read file into readwrite list
+         */
+    static void readResources(QFile &file, QList<QPair<QString, QString> > &readonlyList, QList<QPair<QString, QString> > &readwriteList);
+
+    /**
+         *	\fn static QStringList readProjections(const QStringList fileList, QList<QPair<QString, QString> > &projections);
+         *	\brief Read projections of the files in the data folder
+         *	\returns names of the files not found
+         */
+    static QStringList readProjections(const QStringList fileList, QList<QPair<QString, QString> > &projections);
+
+signals:
+    /**
+         *	\fn void loaded(StartupData data)
+         *	\brief Emitted in the thread of the loader when everything is read
+         */
+    void loaded(StartupData data);
+
+private:
+    QThreadPool pool;
+};
+
+class StartupTask : public QRunnable {
+public:
+    /**
+         *	\fn StartupTask(StartupLoader *, const QStringList)
+         *	\brief Constructor
+         *	\param loader : receiver of the result
+         *	\param projectionFiles : projection files in the data folder
+         */
+    StartupTask(StartupLoader *loader, const QStringList projectionFiles);
+
+    /**
+         *	\fn void run(void);
+         *	\brief Loads everything and posts the result to the loader
+         */
+    void run(void);
+
+private:
+    StartupLoader *loader;
+    const QStringList projectionFiles;
+};
+
+#endif
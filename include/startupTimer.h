@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ *	\file startupTimer.h
+ *	\brief Startup Timer
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef STARTUPTIMER_H
+#define STARTUPTIMER_H
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+/**
+ *	Phase timers of the launch, enabled with the environment variable
+ *	OGR2GUI_STARTUP_TIMING. With "1" the phases are written to stderr once
+ *	the window is ready, with "exit" the application quits afterwards.
+ *	Each line reads "startup <phase> <offset ms> <duration ms>".
+ */
+class StartupTimer {
+public:
+    /**
+         *	\fn static void start(void);
+         *	\brief Starts the clock, called first in main
+         */
+    static void start(void);
+
+    /**
+         *	\fn static void begin(const QString phase);
+         *	\brief Starts a phase, does nothing unless enabled
+         */
+    static void begin(const QString phase);
+
+    /**
+         *	\fn static void end(const QString phase);
+         *	\brief Ends the latest phase of that name
+         */
+    static void end(const QString phase);
+
+    /**
+         *	\fn static bool ready(void);
+         *	\brief Writes the phases when the window is usable
+         *	\returns true if the application should quit now
+         */
+    static bool ready(void);
+
+private:
+    struct Phase {
+        QString name;
+        qint64 offset;
+        qint64 duration;
+    };
+
+    static QMutex mutex;
+    static QElapsedTimer clock;
+    static QList<Phase> phases;
+    // also read by the startup loader thread
+    static QAtomicInt enabled;
+    static bool exitWhenReady;
+};
+
+#endif
@@ -34,6 +34,10 @@
 
 #include <QtTest>
 #include "ogr.h"
+#include "ogr2ogrEngine.h"
+#include "projectionSearch.h"
+#include "conversionSpec.h"
+#include "preflight.h"
 
 class TestOgr: public QObject {
     Q_OBJECT
@@ -55,6 +59,18 @@ private slots:
     void testFeatureCount();
     void testSQLQueryFalseQuery();
     void testSQLQuery();
+    void testFeatureProjection();
+    void testSrsCache();
+    void testTransformBatch();
+    void testSourceCatalog();
+    void testProjectionSearch();
+    void testConversionSpec();
+    void testPreflight();
+    void testTranslateFalseInput();
+    void testTranslateFile();
+    void testTranslateInputFormat();
+    void testTranslateReprojected();
+    void testTranslateCancelled();
 private:
     string path;
     string filename;
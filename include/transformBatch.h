@@ -0,0 +1,131 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ *	\file transformBatch.h
+ *	\brief Batched Coordinate Transformation
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef TRANSFORMBATCH_H
+#define TRANSFORMBATCH_H
+
+#include "ogr_api.h"
+#include "ogr_srs_api.h"
+
+#include <QVector>
+
+class TransformBatch {
+public:
+    /**
+         *	\fn TransformBatch(OGRCoordinateTransformationH, OGRSpatialReferenceH, OGRSpatialReferenceH);
+         *	\brief Constructor
+         *	\param hCT : transformation, see SrsCache::acquire
+         *	\param source : source spatial reference of the geometries
+         *	\param target : target spatial reference of hCT
+         */
+    TransformBatch(OGRCoordinateTransformationH hCT, OGRSpatialReferenceH source, OGRSpatialReferenceH target);
+
+    /**
+         *	\fn void add(OGRGeometryH geometry);
+         *	\brief Gathers the coordinates of a geometry and of its parts,
+         *	       the geometry must live until flush
+         */
+    void add(OGRGeometryH geometry);
+
+    /**
+         *	\fn OGRErr flush(void);
+         *	\brief Transforms the gathered coordinates at once and writes
+         *	       them back to their geometries
+         *	\returns OGRERR_FAILURE if a coordinate failed, the geometries
+         *	         are left unchanged then
+         */
+    OGRErr flush(void);
+
+    /**
+         *	\fn int size(void);
+         *	\brief returns the number of gathered coordinates
+         */
+    int size(void) const;
+
+    /**
+         *	\fn void forwardMercator(const int count, double *x, double *y, int *success);
+         *	\brief Geographic WGS 84 degrees to Pseudo-Mercator meters, EPSG
+         *	       4326 to 3857
+         */
+    static void forwardMercator(const int count, double *x, double *y, int *success);
+
+    /**
+         *	\fn void inverseMercator(const int count, double *x, double *y, int *success);
+         *	\brief Pseudo-Mercator meters to geographic WGS 84 degrees, EPSG
+         *	       3857 to 4326
+         */
+    static void inverseMercator(const int count, double *x, double *y, int *success);
+
+private:
+    enum Kernel {
+        Generic,
+        Forward,
+        Inverse
+    };
+
+    struct Part {
+        OGRGeometryH geometry;
+        int first;
+        int count;
+        bool is3D;
+        bool measured;
+    };
+
+    OGRCoordinateTransformationH hCT;
+    OGRSpatialReferenceH target;
+    Kernel kernel;
+    QVector<OGRGeometryH> geometries;
+    QVector<Part> parts;
+    QVector<double> x;
+    QVector<double> y;
+    QVector<double> z;
+    QVector<double> m;
+    QVector<int> success;
+
+    /**
+         *	\fn int epsg(OGRSpatialReferenceH hSRS);
+         *	\brief returns the EPSG code of a spatial reference, 0 if none
+         */
+    static int epsg(OGRSpatialReferenceH hSRS);
+
+    /**
+         *	\fn void gather(OGRGeometryH geometry);
+         *	\brief Appends the coordinates of the simple parts of a geometry
+         */
+    void gather(OGRGeometryH geometry);
+
+    /**
+         *	\fn void clear(void);
+         *	\brief Forgets the gathered geometries
+         */
+    void clear(void);
+};
+
+#endif
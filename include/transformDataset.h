@@ -0,0 +1,188 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ *	\file transformDataset.h
+ *	\brief Reprojecting Source Dataset
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#ifndef TRANSFORMDATASET_H
+#define TRANSFORMDATASET_H
+
+#include "gdal_priv.h"
+#include "ogrsf_frmts.h"
+#include "transformBatch.h"
+
+#include <QHash>
+#include <QQueue>
+#include <QVector>
+
+/**
+ *	\brief Called for every feature read by TransformLayer, blocks while
+ *	       the reading is paused
+ *	\returns false to end the reading
+ */
+typedef bool (*TransformContinueFunc)(void *pContinueArg);
+
+class TransformLayer : public OGRLayer {
+public:
+    /**
+         *	\fn TransformLayer(OGRLayer *, OGRCoordinateTransformationH, OGRSpatialReferenceH, OGRSpatialReferenceH, const bool, TransformContinueFunc, void *);
+         *	\brief Constructor
+         *	\param poSrcLayer : layer read, owned by its dataset
+         *	\param hCT : transformation from SrsCache::acquire, released
+         *	       by the destructor, NULL to pass the features through
+         *	\param source : source reference picking the kernel
+         *	\param target : target reference of hCT, NULL for the one of
+         *	       the source layer
+         *	\param skipFailures : features failing to transform are dropped
+         *	       with a warning instead of ending the reading
+         *	\param pfnContinue : called for every feature, NULL for none
+         *	\param pContinueArg : argument of pfnContinue
+         */
+    TransformLayer(OGRLayer *poSrcLayer, OGRCoordinateTransformationH hCT, OGRSpatialReferenceH source, OGRSpatialReferenceH target, const bool skipFailures,
+                   TransformContinueFunc pfnContinue = NULL, void *pContinueArg = NULL);
+
+    /**
+         *	\fn ~TransformLayer(void);
+         *	\brief Destructor
+         */
+    ~TransformLayer(void);
+
+    void ResetReading(void);
+    OGRFeature *GetNextFeature(void);
+    OGRErr SetNextByIndex(GIntBig nIndex);
+    OGRFeature *GetFeature(GIntBig nFID);
+    OGRFeatureDefn *GetLayerDefn(void);
+    const char *GetName(void);
+    OGRwkbGeometryType GetGeomType(void);
+    OGRSpatialReference *GetSpatialRef(void);
+    GIntBig GetFeatureCount(int bForce);
+    OGRGeometry *GetSpatialFilter(void);
+    void SetSpatialFilter(OGRGeometry *poGeom);
+    void SetSpatialFilter(int iGeomField, OGRGeometry *poGeom);
+    OGRErr SetAttributeFilter(const char *pszQuery);
+    OGRErr SetIgnoredFields(const char **papszFields);
+    const char *GetFIDColumn(void);
+    const char *GetGeometryColumn(void);
+    OGRStyleTable *GetStyleTable(void);
+    char **GetMetadata(const char *pszDomain = "");
+    const char *GetMetadataItem(const char *pszName, const char *pszDomain = "");
+    int TestCapability(const char *pszCap);
+
+    /**
+         *	\fn bool isFailed(void);
+         *	\brief returns true if reading ended on a feature failing to
+         *	       transform
+         */
+    bool isFailed(void) const;
+
+private:
+    OGRLayer *poSrcLayer;
+    OGRCoordinateTransformationH hCT;
+    OGRSpatialReferenceH target;
+    TransformBatch batch;
+    QQueue<OGRFeature*> features;
+    const bool skipFailures;
+    TransformContinueFunc pfnContinue;
+    void *pContinueArg;
+    bool failed;
+    static const int batchSize = 1024;
+
+    /**
+         *	\fn bool fill(void);
+         *	\brief Reads and transforms the next batch of features
+         *	\returns false if no feature is left
+         */
+    bool fill(void);
+
+    /**
+         *	\fn bool transform(OGRFeature *poFeature);
+         *	\brief Transforms a single feature, reports a failure as ogr2ogr
+         */
+    bool transform(OGRFeature *poFeature);
+
+    /**
+         *	\fn void clear(void);
+         *	\brief Destroys the features read ahead
+         */
+    void clear(void);
+};
+
+class TransformDataset : public GDALDataset {
+public:
+    /**
+         *	\fn TransformDataset* create(GDALDatasetH hDS, const int target, const bool skipFailures, TransformContinueFunc, void *);
+         *	\brief Wraps a source whose layers are read reprojected to an
+         *	       EPSG code in batches, see TransformBatch
+         *	\param hDS : source dataset, must outlive the wrapper
+         *	\param target : target EPSG code, 0 to pass the features through
+         *	\param skipFailures : see TransformLayer
+         *	\param pfnContinue : see TransformLayer
+         *	\param pContinueArg : argument of pfnContinue
+         *	\returns wrapper, NULL for interleaved layers or if a layer has
+         *	         several geometry fields or no spatial reference, those
+         *	         are left to ogr2ogr
+         */
+    static TransformDataset* create(GDALDatasetH hDS, const int target, const bool skipFailures,
+                                    TransformContinueFunc pfnContinue = NULL, void *pContinueArg = NULL);
+
+    /**
+         *	\fn ~TransformDataset(void);
+         *	\brief Destructor, the source stays open
+         */
+    ~TransformDataset(void);
+
+    int GetLayerCount(void);
+    OGRLayer *GetLayer(int iLayer);
+    OGRStyleTable *GetStyleTable(void);
+    char **GetMetadata(const char *pszDomain = "");
+    const char *GetMetadataItem(const char *pszName, const char *pszDomain = "");
+    int TestCapability(const char *pszCap);
+    OGRLayer *ExecuteSQL(const char *pszStatement, OGRGeometry *poSpatialFilter, const char *pszDialect);
+    void ReleaseResultSet(OGRLayer *poResultsSet);
+
+    /**
+         *	\fn bool isFailed(void);
+         *	\brief returns true if a layer failed, see TransformLayer::isFailed
+         */
+    bool isFailed(void) const;
+
+private:
+    GDALDataset *poSrcDS;
+    QVector<TransformLayer*> layers;
+    QHash<OGRLayer*, OGRLayer*> results;
+    const bool skipFailures;
+    TransformContinueFunc pfnContinue;
+    void *pContinueArg;
+
+    /**
+         *	\fn TransformDataset(GDALDataset *, const bool, TransformContinueFunc, void *);
+         *	\brief Constructor
+         */
+    TransformDataset(GDALDataset *poSrcDS, const bool skipFailures, TransformContinueFunc pfnContinue, void *pContinueArg);
+};
+
+#endif
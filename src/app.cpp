@@ -31,17 +31,26 @@
  */
 
 #include "app.h"
+#include <algorithm>
+#include <QtConcurrent>
 
 App::App(QWidget *widget) : QMainWindow(widget) {
     ogr = new Ogr();
     dbConnect = new DBConnect(this);
     wsConnect = new WebServiceConnect(this);
     settings = new Settings(this);
+    queue = new ConversionQueue(this);
+    sourceProbe = new SourceProbe(this);
+    startupLoader = new StartupLoader(this);
+    preflight = new QFutureWatcher<PreflightReport>(this);
+    projectionModel = new ProjectionModel(&projectionsList, this);
 
-    initData();
+    StartupTimer::begin("initInterface");
     initInterface();
     translateInterface();
-    initProjectionFiles();
+    StartupTimer::end("initInterface");
+    initQueue();
+    setLoading(true);
     updateParameters();
 
     setGeometry(
@@ -53,96 +62,90 @@ App::App(QWidget *widget) : QMainWindow(widget) {
         )
     );
     this->show();
+
+    // the window is painted while drivers, resources and projections load
+    initData();
 }
 
 App::~App(void) {
 }
 
 void App::initData(void) {
-    QFile resFormats(":/formats");
-    QFile resDatabases(":/databases");
-    QFile resWebServices(":/webservices");
-    readResources(resFormats, formatsListReadOnly, formatsListReadWrite);
-    readResources(resDatabases, databaseListReadOnly, databaseListReadWrite);
-    readResources(resWebServices, webServiceList);
+    projectionFiles.clear();
+    projectionFiles << "gcs.csv" << "pcs.csv";
+    QObject::connect(startupLoader, SIGNAL(loaded(StartupData)), this, SLOT(evtStartupLoaded(StartupData)));
+    startupLoader->load(projectionFiles);
 }
 
-void App::readResources(QFile &file, QList<QPair<QString, QString> > &readonlyList, QList<QPair<QString, QString> > &readwriteList) {
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-        return;
-    QTextStream in(&file);
-    QString line;
-    QPair<QString, QString> pair;
-    bool readwrite = true;
-    while(!(line = in.readLine()).isNull()) {
-        QStringList t = line.split(",");
-        if(line.compare("#readonly") == 0)
-            readwrite = false;
-        if(t.size() <= 1)
-            continue;
-        if(!t.at(0).isNull())
-            pair.first = t.at(0);
-        if(!t.at(1).isNull())
-            pair.second = t.at(1);
-        readonlyList << pair;
-        if(readwrite)
-            readwriteList << pair;
-    }
-    file.close();
-    qSort(readwriteList.begin(), readwriteList.end());
-    qSort(readonlyList.begin(), readonlyList.end());
+void App::setLoading(const bool loading) {
+    grpSource->setEnabled(!loading);
+    grpTarget->setEnabled(!loading);
+    btnConvert->setEnabled(!loading);
+    mnuSettings->setEnabled(!loading);
+    // a busy indicator until the data arrives
+    progress->setMaximum(loading ? 0 : 100);
 }
 
-void App::initProjectionFiles(void) {
-    const QString file_gcs = "gcs.csv";
-    const QString file_pcs = "pcs.csv";
-    readProjections(file_gcs);
-    readProjections(file_pcs);
-    initProjection();
+void App::evtStartupLoaded(StartupData data) {
+    formatsListReadOnly = data.formatsReadOnly;
+    formatsListReadWrite = data.formatsReadWrite;
+    databaseListReadOnly = data.databasesReadOnly;
+    databaseListReadWrite = data.databasesReadWrite;
+    webServiceList = data.webServices;
+    reportMissingProjections(data.missingProjectionFiles);
+    initProjection(data.projections);
+
+    // the source and target groups were disabled, the file options are still selected
+    evtRadSourceFile();
+    evtRadTargetFile();
+    setLoading(false);
+    updateParameters();
+    if(StartupTimer::ready())
+        QTimer::singleShot(0, qApp, SLOT(quit()));
+}
+
+QList<QPair<QString, QString> > App::readProjections(const QStringList fileList) {
+    QList<QPair<QString, QString> > projections;
+    reportMissingProjections(StartupLoader::readProjections(fileList, projections));
+    return projections;
 }
 
-void App::readProjections(const QString filename) {
-    const QString folder = "data";
-    const QString filepath = QDir::toNativeSeparators(QCoreApplication::applicationDirPath() + QDir::separator() + folder + QDir::separator() + filename);
-    QFile file(filepath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+void App::reportMissingProjections(const QStringList fileList) {
+    foreach(QString filename, fileList) {
         QMessageBox msg;
-        msg.setText(tr("No ") + filename + tr(" file found in folder ") + folder);
+        msg.setText(tr("No ") + filename + tr(" file found in folder ") + "data");
         msg.exec();
-        return;
     }
-    QTextStream in(&file);
-    QString line;
-    QPair<QString, QString> pair;
-    while(!(line = in.readLine()).isNull()) {
-        QStringList t = line.split(",");
-        bool isInteger;
-        t.at(0).toInt(&isInteger);
-        if(!isInteger)
-            continue;
-        if(!t.at(0).isNull())
-            pair.first = t.at(0);
-        if(!t.at(1).isNull())
-            pair.second = t.at(1);
-        projectionsList << pair;
-    }
-    file.close();
 }
 
-bool sortCOORD_REF_SYS_CODE(const QPair<QString, QString> &s1, const QPair<QString, QString> &s2) {
-  return s1.first.toInt() < s2.first.toInt();
+void App::initProjection(const QList<QPair<QString, QString> > projections) {
+    // both combo boxes share one model, display strings are built on demand
+    // and codes are looked up through its index
+    projectionModel->setProjections(projections);
+    cmbSourceProj->setCurrentIndex(0);
+    cmbTargetProj->setCurrentIndex(0);
 }
 
-void App::initProjection() {
-    qSort(projectionsList.begin(), projectionsList.end(), sortCOORD_REF_SYS_CODE);
-    projectionsList.insert(0, QPair<QString, QString>());
-    cmbSourceProj->addItem(QString());
-    cmbTargetProj->addItem(QString());
-    for(int i=1;i<projectionsList.size();++i) {
-        QPair<QString, QString> pair = projectionsList.at(i);
-        cmbSourceProj->addItem(pair.first + " " + pair.second);
-        cmbTargetProj->addItem(pair.first + " " + pair.second);
+int App::matchProjection(const QString text) const {
+    bool isInteger;
+    text.toInt(&isInteger);
+    if(isInteger) {
+        int row = projectionModel->indexOf(text);
+        if(row < 0)
+            row = projectionModel->getSearch().findPrefix(text);
+        return row < 0 ? 0 : row;
     }
+    const QList<int> rows = projectionModel->getSearch().search(text, 1);
+    return rows.isEmpty() ? 0 : rows.first();
+}
+
+void App::completeProjection(QCompleter *completer, const QString text) {
+    QStringList completions;
+    foreach(int row, projectionModel->getSearch().search(text, 20))
+        completions << projectionsList.at(row).first + " " + projectionsList.at(row).second;
+    static_cast<QStringListModel *>(completer->model())->setStringList(completions);
+    if(!completions.isEmpty())
+        completer->complete();
 }
 
 void App::initInterface(void) {
@@ -219,15 +222,37 @@ void App::initLayout(void) {
         txtOptionOutput = new QTextEdit();
         txtOptionOutput->setReadOnly(true);
 
+        tabQueue = new QTableWidget();
+        tabQueue->setColumnCount(3);
+        tabQueue->setMaximumHeight(120);
+        tabQueue->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+        tabQueue->verticalHeader()->setVisible(false);
+        tabQueue->setSelectionBehavior(QAbstractItemView::SelectRows);
+        tabQueue->setSelectionMode(QAbstractItemView::SingleSelection);
+        tabQueue->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
         lytExecute = new QHBoxLayout();
         {
             btnConvert = new QPushButton();
             btnConvert->setMinimumWidth(200);
 
+            btnPause = new QPushButton();
+            btnPause->setCheckable(true);
+            btnPause->setEnabled(false);
+
+            btnCancel = new QPushButton();
+            btnCancel->setEnabled(false);
+
+            btnClear = new QPushButton();
+
             lytExecute->addWidget(btnConvert);
+            lytExecute->addWidget(btnPause);
+            lytExecute->addWidget(btnCancel);
+            lytExecute->addWidget(btnClear);
         }
 
         theLayout->addWidget(txtOptionOutput);
+        theLayout->addWidget(tabQueue);
         theLayout->addLayout(lytExecute);
 
         progress = new QProgressBar();
@@ -311,13 +336,18 @@ void App::initSourceLayout(void) {
             lytSourceProj = new QHBoxLayout();
             {
                 txtSourceProj = new QLineEdit();
-                txtSourceProj->setMaxLength(5);
-                txtSourceProj->setMinimumWidth(50);
-                txtSourceProj->setMaximumWidth(50);
-                QValidator *validator = new QIntValidator(0, 99999, this);
-                txtSourceProj->setValidator(validator);
+                txtSourceProj->setMinimumWidth(120);
+                txtSourceProj->setMaximumWidth(120);
+
+                // accepts an EPSG code or part of a name, matches are ranked by the model index
+                cmpSourceProj = new QCompleter(new QStringListModel(this), this);
+                cmpSourceProj->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+                txtSourceProj->setCompleter(cmpSourceProj);
 
                 cmbSourceProj = new QComboBox();
+                cmbSourceProj->setModel(projectionModel);
+                // sizing to contents would format every projection
+                cmbSourceProj->setSizeAdjustPolicy(QComboBox::AdjustToMinimumContentsLengthWithIcon);
                 cmbSourceProj->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 
                 lytSourceProj->addWidget(txtSourceProj);
@@ -412,13 +442,18 @@ void App::initTargetLayout(void) {
             lytTargetProj = new QHBoxLayout();
             {
                 txtTargetProj = new QLineEdit();
-                txtTargetProj->setMaxLength(5);
-                txtTargetProj->setMinimumWidth(50);
-                txtTargetProj->setMaximumWidth(50);
-                QValidator *validator = new QIntValidator(0, 99999, this);
-                txtTargetProj->setValidator(validator);
+                txtTargetProj->setMinimumWidth(120);
+                txtTargetProj->setMaximumWidth(120);
+
+                // accepts an EPSG code or part of a name, matches are ranked by the model index
+                cmpTargetProj = new QCompleter(new QStringListModel(this), this);
+                cmpTargetProj->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+                txtTargetProj->setCompleter(cmpTargetProj);
 
                 cmbTargetProj = new QComboBox();
+                cmbTargetProj->setModel(projectionModel);
+                // sizing to contents would format every projection
+                cmbTargetProj->setSizeAdjustPolicy(QComboBox::AdjustToMinimumContentsLengthWithIcon);
                 cmbTargetProj->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 
                 lytTargetProj->addWidget(txtTargetProj);
@@ -568,9 +603,12 @@ void App::initSlots(void) {
 
     QObject::connect(cmbSourceFormat, SIGNAL(currentIndexChanged(int)), this, SLOT(evtCmbSourceFormat(void)));
     QObject::connect(txtSourceName, SIGNAL(textChanged(QString)), this, SLOT(evtTxtSourceName(void)));
+    QObject::connect(sourceProbe, SIGNAL(probed(bool, QString, QString, QString)), this, SLOT(evtSourceProbed(bool, QString, QString, QString)));
     QObject::connect(btnSourceName, SIGNAL(clicked(void)), this, SLOT(evtBtnSourceName(void)));
-    QObject::connect(txtSourceQuery, SIGNAL(textChanged(QString)), this, SLOT(evtUpdateParameters(void)));
+    QObject::connect(txtSourceQuery, SIGNAL(textChanged(QString)), this, SLOT(evtTxtSourceQuery(QString)));
     QObject::connect(txtSourceProj, SIGNAL(textChanged(QString)), this, SLOT(evtTxtSourceProj(void)));
+    QObject::connect(txtSourceProj, SIGNAL(textEdited(QString)), this, SLOT(evtTxtSourceProjEdited(QString)));
+    QObject::connect(cmpSourceProj, SIGNAL(activated(QString)), this, SLOT(evtCmpSourceProj(QString)));
     QObject::connect(cmbSourceProj, SIGNAL(currentIndexChanged(int)), this, SLOT(evtCmbSourceProj(void)));
 
     QObject::connect(radTargetFile, SIGNAL(toggled(bool)), this, SLOT(evtRadTargetFile(void)));
@@ -581,18 +619,27 @@ void App::initSlots(void) {
     QObject::connect(txtTargetName, SIGNAL(textChanged(QString)), this, SLOT(evtTxtTargetName(void)));
     QObject::connect(btnTargetName, SIGNAL(clicked()), this, SLOT(evtBtnTargetName(void)));
     QObject::connect(txtTargetProj, SIGNAL(textChanged(QString)), this, SLOT(evtTxtTargetProj(void)));
-    QObject::connect(cmbTargetProj, SIGNAL(currentIndexChanged(int)), this, SLOT(evtUpdateParameters(void)));
-    QObject::connect(btnTargetSpat, SIGNAL(clicked(bool)), this, SLOT(evtUpdateParameters(void)));
-    QObject::connect(btnTargetDSCO, SIGNAL(clicked(bool)), this, SLOT(evtUpdateParameters(void)));
-    QObject::connect(btnTargetLCO, SIGNAL(clicked(bool)), this, SLOT(evtUpdateParameters(void)));
-
-    QObject::connect(radTargetOverwrite, SIGNAL(toggled(bool)), this, SLOT(evtUpdateParameters(void)));
-    QObject::connect(radTargetAppend, SIGNAL(toggled(bool)), this, SLOT(evtUpdateParameters(void)));
-    QObject::connect(radTargetUpdate, SIGNAL(toggled(bool)), this, SLOT(evtUpdateParameters(void)));
-    QObject::connect(radTargetSkipfailures, SIGNAL(toggled(bool)), this, SLOT(evtUpdateParameters(void)));
-
-    QObject::connect(txtOption, SIGNAL(textChanged()), this, SLOT(evtUpdateParameters(void)));
+    QObject::connect(txtTargetProj, SIGNAL(textEdited(QString)), this, SLOT(evtTxtTargetProjEdited(QString)));
+    QObject::connect(cmpTargetProj, SIGNAL(activated(QString)), this, SLOT(evtCmpTargetProj(QString)));
+    QObject::connect(cmbTargetProj, SIGNAL(currentIndexChanged(int)), this, SLOT(evtCmbTargetProj(void)));
+    QObject::connect(btnTargetSpat, SIGNAL(clicked(bool)), this, SLOT(evtBtnTargetSpat(void)));
+    QObject::connect(btnTargetDSCO, SIGNAL(clicked(bool)), this, SLOT(evtBtnTargetDSCO(void)));
+    QObject::connect(btnTargetLCO, SIGNAL(clicked(bool)), this, SLOT(evtBtnTargetLCO(void)));
+
+    QObject::connect(radTargetOverwrite, SIGNAL(toggled(bool)), this, SLOT(evtChkTargetOptions(void)));
+    QObject::connect(radTargetAppend, SIGNAL(toggled(bool)), this, SLOT(evtChkTargetOptions(void)));
+    QObject::connect(radTargetUpdate, SIGNAL(toggled(bool)), this, SLOT(evtChkTargetOptions(void)));
+    QObject::connect(radTargetSkipfailures, SIGNAL(toggled(bool)), this, SLOT(evtChkTargetOptions(void)));
+
+    QObject::connect(txtOption, SIGNAL(textChanged()), this, SLOT(evtTxtOption(void)));
     QObject::connect(btnConvert, SIGNAL(clicked(void)), this, SLOT(evtBtnExecute(void)));
+    QObject::connect(preflight, SIGNAL(finished()), this, SLOT(evtPreflightFinished(void)));
+    QObject::connect(btnPause, SIGNAL(clicked(void)), this, SLOT(evtBtnPause(void)));
+    QObject::connect(btnCancel, SIGNAL(clicked(void)), this, SLOT(evtBtnCancel(void)));
+    QObject::connect(btnClear, SIGNAL(clicked(void)), this, SLOT(evtBtnClear(void)));
+    QObject::connect(tabQueue, SIGNAL(itemSelectionChanged()), this, SLOT(evtTabQueue(void)));
+    QObject::connect(queue, SIGNAL(jobChanged(int)), this, SLOT(evtQueueJobChanged(int)));
+    QObject::connect(queue, SIGNAL(jobProgress(int, int, qlonglong, qlonglong)), this, SLOT(evtQueueJobProgress(int, int, qlonglong, qlonglong)));
 
     QMetaObject::connectSlotsByName(this);
 }
@@ -662,36 +709,38 @@ void App::translateInterface(void) {
     grpOptions->setTitle(tr("Options (advanced)"));
 
     btnConvert->setText(tr("Convert"));
+    btnPause->setText(btnPause->isChecked() ? tr("Resume") : tr("Pause"));
+    btnCancel->setText(tr("Cancel"));
+    btnClear->setText(tr("Clear"));
+    tabQueue->setHorizontalHeaderLabels(QStringList() << tr("Name") << tr("State") << tr("Progress"));
+    for(int i = 0; i < tabQueue->rowCount(); ++i)
+        evtQueueJobChanged(tabQueue->item(i, 0)->data(Qt::UserRole).toInt());
+}
+
+void App::initQueue(void) {
+    QSettings settings("ogr2gui.ini", QSettings::IniFormat);
+    queue->setMaxThreadCount(settings.value("threads", QThread::idealThreadCount()).toInt());
+    queue->setSeparateProcess(settings.value("process").toBool());
+    queue->setMaxRetries(settings.value("retries").toInt());
+}
+
+int App::queueRow(const int id) const {
+    for(int i = 0; i < tabQueue->rowCount(); ++i)
+        if(tabQueue->item(i, 0)->data(Qt::UserRole).toInt() == id)
+            return i;
+    return -1;
+}
+
+int App::selectedJob(void) const {
+    const int row = tabQueue->currentRow();
+    if(row < 0 || tabQueue->selectedItems().isEmpty())
+        return -1;
+    return tabQueue->item(row, 0)->data(Qt::UserRole).toInt();
 }
 
 void App::updateParameters(void) {
-    parameters = "ogr2ogr -f \"" + cmbTargetFormat->currentText() + "\" ";
-    if(!txtTargetName->text().isEmpty())
-        parameters += "\"" + txtTargetName->text()+ "\" ";
-    if(radSourceWebService->isChecked() && !txtSourceName->text().isEmpty())
-        parameters += webServiceList.at(cmbSourceFormat->currentIndex()).second;
-    if(!txtSourceName->text().isEmpty())
-        parameters += "\"" + txtSourceName->text().trimmed() + "\"";
-    if(!cmbSourceProj->currentText().isEmpty())
-        parameters += " -s_srs EPSG:" + projectionsList.at(cmbSourceProj->currentIndex()).first;
-    if(!cmbTargetProj->currentText().isEmpty())
-        parameters += " -t_srs EPSG:" + projectionsList.at(cmbTargetProj->currentIndex()).first;
-    if(!txtSourceQuery->text().isEmpty())
-        parameters += " -sql \"" + txtSourceQuery->text() + "\"";
-    if(radTargetOverwrite->isChecked())
-        parameters += " -overwrite";
-    if(radTargetAppend->isChecked())
-        parameters += " -append";
-    if(radTargetUpdate->isChecked())
-        parameters += " -update";
-    if(radTargetSkipfailures->isChecked())
-        parameters += " -skipfailures";
-    if(radSourceWebService->isChecked())
-        parameters += " " + wsConnect->getSelectedLayers();
-    parameters += currentParameters();
-    if(!txtOption->toPlainText().isEmpty())
-        parameters += " " + txtOption->toPlainText().simplified();
-    txtOptionOutput->setText(parameters);
+    // the command line is only a view of the spec, the slots keep it current
+    txtOptionOutput->setText(spec.command());
     progress->setValue(0);
     txtSourceName->setStyleSheet("");
     txtTargetName->setStyleSheet("");
@@ -700,57 +749,165 @@ void App::updateParameters(void) {
     txtOptionOutput->setStyleSheet("");
 }
 
-QString App::currentParameters(void) const {
-    QString parameters;
-    QString tempParameter;
-    int totalParameters = 0;
+void App::updateSourceSpec(void) {
+    const QString source = txtSourceName->text().trimmed();
+    const bool webService = radSourceWebService->isChecked() && cmbSourceFormat->currentIndex() >= 0;
+    spec.source = source.isEmpty() || !webService ? source : webServiceList.at(cmbSourceFormat->currentIndex()).second + source;
+    spec.inputFormat = cmbSourceFormat->currentText();
+    spec.layers = webService ? wsConnect->getSelectedLayersAsList() : QStringList();
+    spec.layers.removeAll(QString());
+}
+
+QStringList App::selectedLayers(void) const {
+    QStringList layers;
+    if(radSourceWebService->isChecked())
+        layers = wsConnect->getSelectedLayersAsList();
+    else if(radSourceDatabase->isChecked())
+        layers = dbConnect->getSelectedTables();
+    layers.removeAll(QString());
+    return layers;
+}
+
+QFileInfoList App::findBatchFiles(const QString folder, const QString extension) const {
+    QFileInfoList files;
+    QDirIterator it(folder, QStringList() << "*." + extension, QDir::Files, QDirIterator::Subdirectories);
+    while(it.hasNext()) {
+        it.next();
+        files.append(it.fileInfo());
+    }
+    // largest first, so the long translations do not end up last in the queue
+    std::sort(files.begin(), files.end(), [](const QFileInfo &a, const QFileInfo &b) { return a.size() > b.size(); });
+    return files;
+}
+
+bool App::targetAllowsParallelLayers(void) const {
+    // layers can only be written concurrently into a database server
+    // or a folder where each layer gets its own file
+    if(radTargetFolder->isChecked())
+        return true;
+    if(radTargetDatabase->isChecked())
+        return databaseListReadWrite.at(cmbTargetFormat->currentIndex()).first != "SQLite";
+    return false;
+}
+
+int App::enqueueJob(const QString name, const ConversionSpec job, const QList<int> dependencies) {
+    const int id = queue->enqueue(name, job, dependencies);
+    const int row = tabQueue->rowCount();
+    tabQueue->insertRow(row);
+    for(int column = 0; column < tabQueue->columnCount(); ++column)
+        tabQueue->setItem(row, column, new QTableWidgetItem());
+    tabQueue->item(row, 0)->setData(Qt::UserRole, id);
+    evtQueueJobChanged(id);
+    return id;
+}
+
+bool App::enqueueShards(const QString sourcename, const QString targetname, const int shards, const GIntBig counted) {
+    const QStringList &options = spec.extraArguments;
+    if(shards < 2 || ogr->getSourceLayerCount() != 1 || !radSourceFile->isChecked()
+            || !spec.sql.isEmpty() || !spec.where.isEmpty() || options.contains("-where") || options.contains("-sql") || options.contains("-fid") || options.contains("-limit"))
+        return false;
+    // only a database server takes the shards concurrently, a file target
+    // would need its shards merged one after the other
+    if(!radTargetDatabase->isChecked() || !targetAllowsParallelLayers())
+        return false;
+    // counted by the preflight worker, the GUI thread never scans the source
+    GIntBig features = counted;
+    QList<LayerInfo> cached;
+    if(features < 0 && SourceCatalog::lookup(sourcename, cached) && cached.size() == 1)
+        features = cached.first().features;
+    if(features < shards)
+        return false;
+    // FID ranges, the first and last open ended so sparse FIDs are covered too
+    QStringList filters;
+    const GIntBig step = features / shards;
+    for(int i = 0; i < shards; ++i) {
+        QStringList range;
+        if(i > 0)
+            range << "FID >= " + QString::number(i * step);
+        if(i < shards - 1)
+            range << "FID < " + QString::number((i + 1) * step);
+        filters << range.join(" AND ");
+    }
+    ConversionSpec shard = spec;
+    shard.source = sourcename;
+    shard.target = targetname;
+    // a job without features creates the table, all shards then append
+    // to it concurrently. GDAL 2.1 has no -limit, no feature matches 1=0
+    ConversionSpec schema = shard;
+    schema.where = "1=0";
+    const int table = enqueueJob(sourcename + " " + tr("table") + " " + targetname, schema);
+    shard.overwrite = false;
+    shard.update = false;
+    shard.append = true;
+    for(int i = 0; i < shards; ++i) {
+        shard.where = filters.at(i);
+        enqueueJob(sourcename + " [" + QString::number(i + 1) + "/" + QString::number(shards) + "] as " + targetname,
+                   shard, QList<int>() << table);
+    }
+    return true;
+}
+
+void App::evtBtnTargetSpat(void) {
+    spec.spatialFilter = spatialFilter();
+    updateParameters();
+}
+
+QStringList App::spatialFilter(void) const {
+    QStringList values;
     for(int x=0; x<tabTargetSpat->rowCount(); ++x) {
         for(int y=0; y<tabTargetSpat->columnCount(); ++y) {
             QLineEdit *cellLineEdit = static_cast<QLineEdit*>(tabTargetSpat->cellWidget(x, y));
-            if(cellLineEdit != 0)
-                if(!cellLineEdit->text().isEmpty()) {
-                    tempParameter += " " + cellLineEdit->text();
-                    ++totalParameters;
-                }
+            if(cellLineEdit != 0 && !cellLineEdit->text().isEmpty())
+                values << cellLineEdit->text();
         }
     }
-    if(!tempParameter.isEmpty() && totalParameters == 4)
-        parameters += " -spat" + tempParameter;
-    if(tempParameter.isEmpty() || totalParameters == 4)
+    if(values.isEmpty() || values.size() == 4)
         tabTargetSpat->setStyleSheet("");
     else
         tabTargetSpat->setStyleSheet("background-color: red");
-    tempParameter.clear();
-    totalParameters = 0;
-    QLineEdit *cellName = static_cast<QLineEdit*>(tabTargetDSCO->cellWidget(0, 0));
-    QLineEdit *cellValue = static_cast<QLineEdit*>(tabTargetDSCO->cellWidget(0, 1));
-    if(cellName != 0 && cellValue != 0)
-        if(!cellName->text().isEmpty() && !cellValue->text().isEmpty()) {
-            tempParameter = " " + cellName->text() + "=" + cellValue->text();
-            totalParameters = 2;
-        }
-    if(!tempParameter.isEmpty() && totalParameters == 2)
-        parameters += " -dsco" + tempParameter;
-    if((cellName->text().isEmpty() && cellValue->text().isEmpty()) || totalParameters == 2)
-        tabTargetDSCO->setStyleSheet("");
-    else
-        tabTargetDSCO->setStyleSheet("background-color: red");
-    tempParameter.clear();
-    totalParameters = 0;
-    cellName = static_cast<QLineEdit*>(tabTargetLCO->cellWidget(0, 0));
-    cellValue = static_cast<QLineEdit*>(tabTargetLCO->cellWidget(0, 1));
-    if(cellName != 0 && cellValue != 0)
-        if(!cellName->text().isEmpty() && !cellValue->text().isEmpty()) {
-            tempParameter = " " + cellName->text() + "=" + cellValue->text();
-            totalParameters = 2;
-        }
-    if(!tempParameter.isEmpty() && totalParameters == 2)
-        parameters += " -lco" + tempParameter;
-    if((cellName->text().isEmpty() && cellValue->text().isEmpty()) || totalParameters == 2)
-        tabTargetLCO->setStyleSheet("");
+    return values.size() == 4 ? values : QStringList();
+}
+
+QString App::creationOption(QTableWidget *table) const {
+    QLineEdit *cellName = static_cast<QLineEdit*>(table->cellWidget(0, 0));
+    QLineEdit *cellValue = static_cast<QLineEdit*>(table->cellWidget(0, 1));
+    QString option;
+    if(cellName != 0 && cellValue != 0 && !cellName->text().isEmpty() && !cellValue->text().isEmpty())
+        option = cellName->text() + "=" + cellValue->text();
+    if(!option.isEmpty() || (cellName->text().isEmpty() && cellValue->text().isEmpty()))
+        table->setStyleSheet("");
     else
-        tabTargetLCO->setStyleSheet("background-color: red");
-    return parameters;
+        table->setStyleSheet("background-color: red");
+    return option;
+}
+
+void App::evtBtnTargetDSCO(void) {
+    spec.datasetCreationOption = creationOption(tabTargetDSCO);
+    updateParameters();
+}
+
+void App::evtBtnTargetLCO(void) {
+    spec.layerCreationOption = creationOption(tabTargetLCO);
+    updateParameters();
+}
+
+void App::evtTxtSourceQuery(QString text) {
+    spec.sql = text;
+    updateParameters();
+}
+
+void App::evtChkTargetOptions(void) {
+    spec.overwrite = radTargetOverwrite->isChecked();
+    spec.append = radTargetAppend->isChecked();
+    spec.update = radTargetUpdate->isChecked();
+    spec.skipFailures = radTargetSkipfailures->isChecked();
+    updateParameters();
+}
+
+void App::evtTxtOption(void) {
+    // tokenized once here instead of for every job
+    spec.extraArguments = ConversionSpec::tokenize(txtOption->toPlainText());
+    updateParameters();
 }
 
 void App::evtMnuSettings(void) {
@@ -761,15 +918,16 @@ void App::evtMnuSettings(void) {
         settings->translateInterface();
         wsConnect->translateInterface();
 
-        cmbSourceProj->clear();
-        cmbTargetProj->clear();
-        projectionsList.clear();
         QStringList fileList = settings->getProjectionFileList();
-        if(!fileList.isEmpty())
-            foreach(QString file, fileList)
-                readProjections(file);
-        initProjection();
-        evtTxtSourceName();
+        if(fileList != projectionFiles) {
+            projectionFiles = fileList;
+            QList<QPair<QString, QString> > projections;
+            if(!fileList.isEmpty())
+                projections = readProjections(fileList);
+            initProjection(projections);
+            evtTxtSourceName();
+        }
+        initQueue();
     }
 }
 
@@ -879,37 +1037,39 @@ void App::evtCmbSourceFormat(void) {
     txtSourceName->clear();
     txtSourceProj->clear();
     txtSourceQuery->clear();
+    updateSourceSpec();
+    updateParameters();
 }
 
 void App::evtTxtSourceName(void) {
+    updateSourceSpec();
     QString sourceName = txtSourceName->text().trimmed();
-    if(sourceName.isEmpty() || sourceName.isNull())
+    if(sourceName.isEmpty() || sourceName.isNull()) {
+        updateParameters();
         return;
-    string name = sourceName.toStdString();
-    string epsg, query, error;
+    }
+    if(radSourceWebService->isChecked())
+        sourceName = webServiceList.at(0).second + sourceName;
+    // opening may take seconds for network paths and databases
+    sourceProbe->probe(sourceName, cmbSourceFormat->currentText());
+    updateParameters();
+}
 
+void App::evtSourceProbed(bool isOpen, QString, QString epsg, QString query) {
     QString sourceProjInitTemp = txtSourceProjInit->text();
     int sourceProjIndex = cmbSourceProj->currentIndex();
 
-    if(radSourceWebService->isChecked())
-        name = webServiceList.at(0).second.toStdString() + name;
-    bool isOpen = ogr->openSource(name, epsg, query, error);
     if(isOpen) {
         txtSourceProj->clear();
         txtSourceProjInit->clear();
         sourceProjInit.clear();
         cmbSourceProj->setCurrentIndex(0);
-        for(int i = 0; i < projectionsList.size(); ++i) {
-            if(projectionsList.at(i).first.compare(QString::fromStdString(epsg)) == 0) {
-                if(i>0)
-                    txtSourceProjInit->setText(projectionsList.at(i).first + " " + projectionsList.at(i).second);
-                break;
-            }
-        }
-        ogr->closeSource();
+        const int row = projectionModel->indexOf(epsg);
+        if(row > 0)
+            txtSourceProjInit->setText(projectionsList.at(row).first + " " + projectionsList.at(row).second);
         sourceProjInit = txtSourceProjInit->text();
         if(radSourceFile->isChecked())
-            txtSourceQuery->setText(query.c_str());
+            txtSourceQuery->setText(query);
         else if(radSourceWebService->isChecked())
             btnSourceName->setText(tr("Connected"));
     } else {
@@ -917,7 +1077,7 @@ void App::evtTxtSourceName(void) {
         if(radSourceWebService->isChecked())
             btnSourceName->setText(tr("Open"));
     }
-    if(QString::fromStdString(epsg).isEmpty() || sourceProjInit.isEmpty()) {
+    if(epsg.isEmpty() || sourceProjInit.isEmpty()) {
         QString sourceProjTemp = projectionsList.at(sourceProjIndex).first + " " + projectionsList.at(sourceProjIndex).second;
         if(sourceProjTemp.compare(sourceProjInitTemp) == 0) {
             txtSourceProjInit->setText(sourceProjInitTemp);
@@ -984,17 +1144,22 @@ void App::evtTxtSourceProj(void) {
         txtSourceProjInit->setText(sourceProjInit);
         cmbSourceProj->setCurrentIndex(0);
     } else {
-        for(int i = 0; i < projectionsList.size(); ++i) {
-            if(projectionsList.at(i).first.startsWith(projection)) {
-                cmbSourceProj->setCurrentIndex(i);
-                break;
-            }
-        }
+        cmbSourceProj->setCurrentIndex(matchProjection(projection));
     }
     updateParameters();
 }
 
+void App::evtTxtSourceProjEdited(QString text) {
+    completeProjection(cmpSourceProj, text);
+}
+
+void App::evtCmpSourceProj(QString text) {
+    txtSourceProj->setText(text.section(' ', 0, 0));
+}
+
 void App::evtCmbSourceProj(void) {
+    const int index = cmbSourceProj->currentIndex();
+    spec.sourceSrs = index > 0 ? projectionsList.at(index).first : QString();
     txtSourceProjInit->clear();
     if(cmbSourceProj->currentIndex() > 0) {
         txtSourceProjInit->setText(projectionsList.at(cmbSourceProj->currentIndex()).first + " " + projectionsList.at(cmbSourceProj->currentIndex()).second);
@@ -1035,11 +1200,19 @@ void App::evtRadTargetDatabase(void) {
 }
 
 void App::evtCmbTargetFormat(void) {
+    spec.targetFormat = cmbTargetFormat->currentText();
     txtTargetName->clear();
     updateParameters();
 }
 
 void App::evtTxtTargetName(void) {
+    spec.target = txtTargetName->text();
+    updateParameters();
+}
+
+void App::evtCmbTargetProj(void) {
+    const int index = cmbTargetProj->currentIndex();
+    spec.targetSrs = index > 0 ? projectionsList.at(index).first : QString();
     updateParameters();
 }
 
@@ -1076,73 +1249,77 @@ void App::evtTxtTargetProj(void) {
     if(projection.isEmpty()) {
         cmbTargetProj->setCurrentIndex(0);
     } else {
-        for(int i = 0; i < projectionsList.size(); ++i) {
-            if(projectionsList.at(i).first.startsWith(projection)) {
-                cmbTargetProj->setCurrentIndex(i);
-                break;
-            }
-        }
+        cmbTargetProj->setCurrentIndex(matchProjection(projection));
     }
     updateParameters();
 }
 
-void App::evtUpdateParameters(void) {
-    updateParameters();
+void App::evtTxtTargetProjEdited(QString text) {
+    completeProjection(cmpTargetProj, text);
+}
+
+void App::evtCmpTargetProj(QString text) {
+    txtTargetProj->setText(text.section(' ', 0, 0));
 }
 
 void App::evtBtnExecute(void) {
+    // values typed without Paste Option count as well
+    spec.spatialFilter = spatialFilter();
+    spec.datasetCreationOption = creationOption(tabTargetDSCO);
+    spec.layerCreationOption = creationOption(tabTargetLCO);
     updateParameters();
 
-    QString sourcename = txtSourceName->text().trimmed();
-    QString targetname = txtTargetName->text().trimmed();
-    string epsg;
-    string query;
-    string error;
-
-    bool resVal = true;
-    QStringList fileList;
-    if(radSourceWebService->isChecked()) {
-        fileList = wsConnect->getSelectedLayersAsList();
-        sourcename = webServiceList.at(cmbSourceFormat->currentIndex()).second + sourcename;
-    }
-    if(fileList.size() > 0) {
-        for(int i=0; i<fileList.size(); ++i) {
-            if(!ogr->openSource(sourcename.toStdString(), fileList.at(i).toStdString(), epsg, query, error)) {
-                resVal = false;
-                break;
-            }
-        }
-    } else {
-        resVal = ogr->openSource(sourcename.toStdString(), epsg, query, error);
-    }
+    PreflightRequest request;
+    request.source = spec.source;
+    request.sourceFormat = cmbSourceFormat->currentText();
+    if(radSourceWebService->isChecked())
+        request.layers = wsConnect->getSelectedLayersAsList();
+    request.query = spec.sql;
+    request.targetFormat = spec.targetFormat;
+    request.targetProjection = spec.targetSrs.toInt();
+    request.testFeatures = !radSourceDatabase->isChecked() && !radSourceWebService->isChecked()
+            && (spec.sourceSrs.isEmpty() || !spec.targetSrs.isEmpty()) && !txtTargetName->text().isEmpty();
+    QSettings settings("ogr2gui.ini", QSettings::IniFormat);
+    request.samples = settings.value("samples").toInt();
+    // the FID ranges of the shards need the feature count
+    request.countFeatures = settings.value("shards").toInt() > 1 && radSourceFile->isChecked() && radTargetDatabase->isChecked() && spec.sql.isEmpty();
+
+    // the widgets stay disabled until the report arrives, the spec can not change
+    setLoading(true);
+    preflight->setFuture(QtConcurrent::run(Preflight::run, ogr, request));
+}
+
+void App::evtPreflightFinished(void) {
+    const PreflightReport report = preflight->result();
+    setLoading(false);
+    const QString sourcename = spec.source;
+    const QString targetname = txtTargetName->text().trimmed();
 
     int progressSteps = 1;
     int maxValue = 100;
     bool failed = false;
     txtOptionOutput->append("\n");
-    if(!resVal) {
+    if(!report.sourceOpened) {
         // FAILURE: unable to open source!
         txtSourceName->setStyleSheet("background-color: red");
         ++progressSteps;
         failed = true;
     }
-    if(!cmbSourceProj->currentText().isEmpty()) {
-        if(cmbTargetProj->currentText().isEmpty()) {
+    if(!spec.sourceSrs.isEmpty()) {
+        if(spec.targetSrs.isEmpty()) {
             // FAILURE: if -s_srs is specified, -t_srs must also be specified!
             cmbTargetProj->setStyleSheet("background-color: red");
             ++progressSteps;
             failed = true;
         }
     }
-    if(!txtSourceQuery->text().isEmpty()) {
-        if(!ogr->testExecuteSQL(txtSourceQuery->text().toStdString())) {
-            // FAILURE: unable to execute sql query!
-            txtSourceQuery->setStyleSheet("background-color: red");
-            ++progressSteps;
-            failed = true;
-        }
+    if(!report.queryValid) {
+        // FAILURE: unable to execute sql query!
+        txtSourceQuery->setStyleSheet("background-color: red");
+        ++progressSteps;
+        failed = true;
     }
-    if(!ogr->openDriver(cmbTargetFormat->currentText().toStdString())) {
+    if(!report.driverFound) {
         // FAILURE: unable to open driver!
         txtOptionOutput->setStyleSheet("background-color: red");
         ++progressSteps;
@@ -1158,26 +1335,155 @@ void App::evtBtnExecute(void) {
         progress->setValue(maxValue/progressSteps);
         return;
     }
-    if(!ogr->testSpatialReference((projectionsList.at(cmbTargetProj->currentIndex()).first).toInt()))
+    if(!report.projectionValid)
         txtOptionOutput->append(tr("FAILURE: unable to create spatial reference!"));
-    if(!radSourceDatabase->isChecked() &&!radSourceWebService->isChecked())
-        if(!ogr->testFeatureProjection())
-            txtOptionOutput->append(tr("FAILURE: unable to transform feature with projection!"));
+    if(!report.featuresTransformed)
+        txtOptionOutput->append(tr("FAILURE: unable to transform feature with projection!"));
+    QSettings settings("ogr2gui.ini", QSettings::IniFormat);
     txtOptionOutput->append(sourcename + " as " + targetname);
-    QString parameters = currentParameters();
-    QString command = QDir::toNativeSeparators(QCoreApplication::applicationFilePath());
-    if(radSourceWebService->isChecked())
-        parameters += " " + wsConnect->getSelectedLayers();
-    if(!txtOption->toPlainText().isEmpty())
-        parameters += " " + txtOption->toPlainText();
-    command += parameters;
-    if(ogr->openOgr2ogr(command, btnConvert)) {
-        progress->setValue(maxValue);
-        txtOptionOutput->append("\n" + QString::number(maxValue) + "% SUCCESS");
-    } else {
-        txtOptionOutput->append(tr("FAILURE: unable to open ogr2ogr!"));
-        txtOptionOutput->setStyleSheet("background-color: red");
-        progress->setValue(maxValue/++progressSteps);
+    const QStringList layers = selectedLayers();
+    if(settings.value("batch").toBool() && radSourceFolder->isChecked() && txtSourceQuery->text().isEmpty()) {
+        if(radTargetFolder->isChecked() || targetAllowsParallelLayers()) {
+            const QFileInfoList files = findBatchFiles(sourcename, formatsListReadOnly.at(cmbSourceFormat->currentIndex()).second);
+            const QString extension = formatsListReadWrite.at(cmbTargetFormat->currentIndex()).second;
+            const bool update = radTargetOverwrite->isChecked() || radTargetAppend->isChecked() || radTargetUpdate->isChecked();
+            const QDir sourceDir(sourcename);
+            txtOptionOutput->append(QString::number(files.size()) + tr(" files found"));
+            for(int i = 0; i < files.size(); ++i) {
+                const QString source = QDir::toNativeSeparators(files.at(i).absoluteFilePath());
+                QString target = targetname;
+                if(radTargetFolder->isChecked()) {
+                    // mirror the source tree below the target folder
+                    const QString relative = sourceDir.relativeFilePath(files.at(i).absolutePath());
+                    const QDir targetDir(QDir(targetname).filePath(relative));
+                    targetDir.mkpath(".");
+                    target = QDir::toNativeSeparators(targetDir.filePath(files.at(i).completeBaseName() + "." + extension));
+                }
+                ConversionSpec job = spec;
+                job.source = source;
+                job.target = target;
+                job.layers.clear();
+                job.update = job.update || !(update || radTargetFolder->isChecked());
+                enqueueJob(source + " as " + target, job);
+            }
+            ogr->closeSource();
+            return;
+        }
+        txtOptionOutput->append(tr("target can not be written by parallel jobs, translating the folder in one job"));
     }
+    if(settings.value("splitlayers").toBool() && layers.size() > 1 && txtSourceQuery->text().isEmpty()) {
+        if(targetAllowsParallelLayers()) {
+            // every job opens the target in update mode and adds its layer
+            if(radTargetFolder->isChecked())
+                QDir().mkpath(targetname);
+            const bool update = radTargetOverwrite->isChecked() || radTargetAppend->isChecked() || radTargetUpdate->isChecked();
+            ConversionSpec job = spec;
+            job.update = job.update || !update;
+            for(int i = 0; i < layers.size(); ++i) {
+                job.layers = QStringList() << layers.at(i);
+                enqueueJob(sourcename + " [" + layers.at(i) + "] as " + targetname, job);
+            }
+            ogr->closeSource();
+            return;
+        }
+        txtOptionOutput->append(tr("target can not be written by parallel jobs, translating layers in one job"));
+    }
+    if(enqueueShards(sourcename, targetname, settings.value("shards").toInt(), report.features)) {
+        ogr->closeSource();
+        return;
+    }
+    enqueueJob(sourcename + " as " + targetname, spec);
     ogr->closeSource();
 }
+
+void App::evtQueueJobChanged(int id) {
+    const int row = queueRow(id);
+    if(row < 0)
+        return;
+    QString state;
+    switch(queue->getState(id)) {
+    case ConversionQueue::Queued: state = tr("Queued"); break;
+    case ConversionQueue::Running: state = tr("Running"); break;
+    case ConversionQueue::Succeeded: state = tr("Succeeded"); break;
+    case ConversionQueue::Failed: state = tr("Failed"); break;
+    case ConversionQueue::Cancelled: state = tr("Cancelled"); break;
+    }
+    const bool reported = tabQueue->item(row, 1)->data(Qt::UserRole).toBool();
+    tabQueue->item(row, 0)->setText(queue->getName(id));
+    tabQueue->item(row, 0)->setToolTip(queue->getCommand(id));
+    tabQueue->item(row, 1)->setText(state);
+    tabQueue->item(row, 1)->setToolTip(queue->getMessage(id));
+    if(queue->getState(id) == ConversionQueue::Queued)
+        jobTimers.remove(id);
+    if(queue->getState(id) == ConversionQueue::Running && !jobTimers.contains(id))
+        jobTimers[id].start();
+    if(queue->isFinished(id)) {
+        tabQueue->item(row, 2)->setText(QString::number(queue->getProgress(id)) + "%");
+        jobTimers.remove(id);
+        if(!reported) {
+            // report each job once in the output
+            tabQueue->item(row, 1)->setData(Qt::UserRole, true);
+            txtOptionOutput->append(queue->getName(id));
+            if(queue->getState(id) == ConversionQueue::Succeeded) {
+                txtOptionOutput->append("100% SUCCESS");
+            } else {
+                if(!queue->getMessage(id).isEmpty())
+                    txtOptionOutput->append(queue->getMessage(id));
+                txtOptionOutput->append(tr("FAILURE: unable to translate with ogr2ogr!"));
+                txtOptionOutput->setStyleSheet("background-color: red");
+            }
+        }
+    }
+    int total = 0;
+    foreach(int job, queue->getIds())
+        total += queue->getProgress(job);
+    progress->setValue(queue->getIds().isEmpty() ? 0 : total / queue->getIds().size());
+    evtTabQueue();
+}
+
+void App::evtQueueJobProgress(int id, int percent, qlonglong features, qlonglong bytes) {
+    const int row = queueRow(id);
+    if(row < 0 || !jobTimers.contains(id))
+        return;
+    const qint64 elapsed = jobTimers[id].elapsed();
+    QString status = QString::number(percent) + "%";
+    if(features >= 0 && elapsed > 0)
+        status += " - " + QString::number(features * 1000 / elapsed) + tr(" features/s");
+    if(bytes >= 0)
+        status += " - " + QString::number(bytes / 1048576.0, 'f', 1) + " MB";
+    if(percent > 0 && percent < 100) {
+        const QTime eta = QTime(0, 0).addMSecs(elapsed * (100 - percent) / percent);
+        status += " - " + tr("ETA") + " " + eta.toString("hh:mm:ss");
+    }
+    tabQueue->item(row, 2)->setText(status);
+}
+
+void App::evtTabQueue(void) {
+    const int id = selectedJob();
+    const bool running = id >= 0 && queue->getState(id) == ConversionQueue::Running;
+    if(!running)
+        btnPause->setChecked(false);
+    btnPause->setEnabled(running);
+    btnPause->setText(btnPause->isChecked() ? tr("Resume") : tr("Pause"));
+    btnCancel->setEnabled(id >= 0 && !queue->isFinished(id));
+}
+
+void App::evtBtnPause(void) {
+    if(!queue->pause(selectedJob(), btnPause->isChecked()))
+        btnPause->setChecked(false);
+    btnPause->setText(btnPause->isChecked() ? tr("Resume") : tr("Pause"));
+}
+
+void App::evtBtnCancel(void) {
+    btnPause->setEnabled(false);
+    btnCancel->setEnabled(false);
+    queue->cancel(selectedJob());
+}
+
+void App::evtBtnClear(void) {
+    queue->clearFinished();
+    for(int i = tabQueue->rowCount() - 1; i >= 0; --i)
+        if(!queue->getIds().contains(tabQueue->item(i, 0)->data(Qt::UserRole).toInt()))
+            tabQueue->removeRow(i);
+    evtTabQueue();
+}
@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file benchStartup.cpp
+ *	\brief Startup Benchmark
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ *
+ *	Usage: OGR2GUI_bench [runs] [executable]
+ *
+ *	Cold runs delete the projection index first so the CSV files are parsed
+ *	again, warm runs reuse it. The executable defaults to OGR2GUI next to
+ *	the benchmark and is started in its own folder.
+ */
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QStringList>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+
+typedef QMap<QString, QList<double> > Samples;
+
+static double percentile(QList<double> values, const double p) {
+    if(values.isEmpty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    // nearest rank
+    const int rank = qBound(1, static_cast<int>(std::ceil(p / 100.0 * values.size())), values.size());
+    return values.at(rank - 1);
+}
+
+static bool launch(const QString executable, Samples &samples) {
+    QProcess process;
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert("OGR2GUI_STARTUP_TIMING", "exit");
+    process.setProcessEnvironment(environment);
+    process.setWorkingDirectory(QFileInfo(executable).absolutePath());
+    QElapsedTimer timer;
+    timer.start();
+    process.start(executable, QStringList());
+    if(!process.waitForFinished(120000) || process.exitCode() != 0)
+        return false;
+    samples["process"] << timer.nsecsElapsed() / 1000000.0;
+    foreach(QString line, QString::fromLocal8Bit(process.readAllStandardError()).split('\n')) {
+        const QStringList fields = line.trimmed().split(' ');
+        if(fields.size() == 4 && fields.at(0) == "startup")
+            samples[fields.at(1)] << fields.at(3).toDouble();
+    }
+    return samples.contains("ready");
+}
+
+static void report(QTextStream &out, const QString mode, const Samples &samples) {
+    out << mode << "\n";
+    out << QString("%1 %2 %3 %4 %5\n").arg("phase", -16).arg("p50", 10).arg("p90", 10).arg("p99", 10).arg("runs", 6);
+    for(Samples::const_iterator it = samples.begin(); it != samples.end(); ++it) {
+        out << QString("%1 %2 %3 %4 %5\n").arg(it.key(), -16)
+               .arg(percentile(it.value(), 50), 10, 'f', 1)
+               .arg(percentile(it.value(), 90), 10, 'f', 1)
+               .arg(percentile(it.value(), 99), 10, 'f', 1)
+               .arg(it.value().size(), 6);
+    }
+    out << "\n";
+}
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    const QStringList args = app.arguments();
+    const int runs = args.size() > 1 ? qMax(1, args.at(1).toInt()) : 10;
+#ifdef Q_OS_WIN
+    QString executable = QDir(app.applicationDirPath()).filePath("OGR2GUI.exe");
+#else
+    QString executable = QDir(app.applicationDirPath()).filePath("OGR2GUI");
+#endif
+    if(args.size() > 2)
+        executable = QFileInfo(args.at(2)).absoluteFilePath();
+    const QString index = QDir(QFileInfo(executable).absolutePath()).filePath("ogr2gui.idx");
+
+    Samples cold;
+    for(int i = 0; i < runs; ++i) {
+        QFile::remove(index);
+        if(!launch(executable, cold)) {
+            out << "failed to start " << executable << "\n";
+            return 1;
+        }
+    }
+    Samples warm;
+    for(int i = 0; i < runs; ++i) {
+        if(!launch(executable, warm)) {
+            out << "failed to start " << executable << "\n";
+            return 1;
+        }
+    }
+    out << "times in ms\n\n";
+    report(out, "cold", cold);
+    report(out, "warm", warm);
+    return 0;
+}
@@ -0,0 +1,229 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file conversionQueue.cpp
+ *	\brief Conversion Queue
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "conversionQueue.h"
+
+ConversionQueue::ConversionQueue(QObject *parent) : QObject(parent), nextId(0), maxRetries(0), separateProcess(false) {
+}
+
+ConversionQueue::~ConversionQueue(void) {
+    QMap<int, Entry>::iterator it;
+    for(it = jobs.begin(); it != jobs.end(); ++it)
+        it->job->cancel();
+    pool.clear();
+    pool.waitForDone();
+    for(it = jobs.begin(); it != jobs.end(); ++it)
+        delete it->job;
+}
+
+int ConversionQueue::enqueue(const QString name, const ConversionSpec spec, const QList<int> dependencies) {
+    const int id = nextId++;
+    Entry entry;
+    entry.job = new Ogr2ogrJob(id, name, spec, separateProcess);
+    entry.dependencies = dependencies;
+    // a partly applied -append would add its features twice
+    entry.retryable = spec.isIdempotent();
+    entry.held = !dependencies.isEmpty();
+    jobs.insert(id, entry);
+    connect(entry.job, SIGNAL(started()), this, SLOT(evtStarted()));
+    connect(entry.job, SIGNAL(translated(bool, QString)), this, SLOT(evtTranslated(bool, QString)));
+    connect(entry.job, SIGNAL(progressChanged(int, qlonglong, qlonglong)), this, SLOT(evtProgress(int, qlonglong, qlonglong)));
+    emit jobChanged(id);
+    if(entry.held)
+        startReady();
+    else
+        pool.start(entry.job);
+    return id;
+}
+
+void ConversionQueue::setMaxThreadCount(const int count) {
+    pool.setMaxThreadCount(qMax(1, count));
+}
+
+void ConversionQueue::setSeparateProcess(const bool enable) {
+    separateProcess = enable;
+}
+
+void ConversionQueue::setMaxRetries(const int count) {
+    maxRetries = qMax(0, count);
+}
+
+void ConversionQueue::cancel(const int id) {
+    if(!jobs.contains(id) || isFinished(id))
+        return;
+    Entry &entry = jobs[id];
+    entry.cancelled = true;
+    entry.job->cancel();
+    // a queued job leaves the pool right away once it gets a thread,
+    // a held one never entered it
+    if(entry.state == Queued) {
+        entry.state = Cancelled;
+        entry.message = tr("cancelled by user");
+        if(entry.held) {
+            entry.held = false;
+            entry.done = true;
+        }
+        emit jobChanged(id);
+        startReady();
+    }
+}
+
+bool ConversionQueue::pause(const int id, const bool enable) {
+    if(!jobs.contains(id) || jobs[id].state != Running)
+        return false;
+    return jobs[id].job->pause(enable);
+}
+
+void ConversionQueue::clearFinished(void) {
+    QMap<int, Entry>::iterator it = jobs.begin();
+    while(it != jobs.end()) {
+        if(it->done) {
+            delete it->job;
+            it = jobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+QList<int> ConversionQueue::getIds(void) const {
+    return jobs.keys();
+}
+
+bool ConversionQueue::isFinished(const int id) const {
+    const State state = getState(id);
+    return state == Succeeded || state == Failed || state == Cancelled;
+}
+
+ConversionQueue::State ConversionQueue::getState(const int id) const {
+    return jobs.value(id).state;
+}
+
+QString ConversionQueue::getName(const int id) const {
+    return jobs.contains(id) ? jobs[id].job->getName() : QString();
+}
+
+QString ConversionQueue::getCommand(const int id) const {
+    return jobs.contains(id) ? jobs[id].job->getCommand() : QString();
+}
+
+int ConversionQueue::getProgress(const int id) const {
+    return jobs.value(id).percent;
+}
+
+QString ConversionQueue::getMessage(const int id) const {
+    return jobs.value(id).message;
+}
+
+int ConversionQueue::senderId(void) const {
+    Ogr2ogrJob *job = qobject_cast<Ogr2ogrJob*>(sender());
+    if(job == NULL || !jobs.contains(job->getId()))
+        return -1;
+    return job->getId();
+}
+
+void ConversionQueue::evtStarted(void) {
+    const int id = senderId();
+    if(id < 0 || jobs[id].state != Queued)
+        return;
+    jobs[id].state = Running;
+    emit jobChanged(id);
+}
+
+void ConversionQueue::evtTranslated(bool success, QString error) {
+    const int id = senderId();
+    if(id < 0)
+        return;
+    Entry &entry = jobs[id];
+    if(!success && !entry.cancelled && entry.retryable && entry.attempts < maxRetries) {
+        ++entry.attempts;
+        entry.state = Queued;
+        entry.percent = 0;
+        entry.message = error + "\n" + tr("retry %1 of %2").arg(entry.attempts).arg(maxRetries);
+        pool.start(entry.job);
+        emit jobChanged(id);
+        return;
+    }
+    entry.done = true;
+    if(success) {
+        entry.state = Succeeded;
+        entry.percent = 100;
+    } else {
+        entry.state = entry.cancelled ? Cancelled : Failed;
+    }
+    entry.message = error;
+    emit jobChanged(id);
+    startReady();
+}
+
+void ConversionQueue::startReady(void) {
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        QMap<int, Entry>::iterator it;
+        for(it = jobs.begin(); it != jobs.end(); ++it) {
+            if(!it->held)
+                continue;
+            bool ready = true;
+            bool broken = false;
+            foreach(int dependency, it->dependencies) {
+                // cleared jobs had succeeded, otherwise this one would be dropped already
+                if(!jobs.contains(dependency))
+                    continue;
+                const State state = getState(dependency);
+                if(state == Failed || state == Cancelled)
+                    broken = true;
+                else if(state != Succeeded)
+                    ready = false;
+            }
+            if(broken) {
+                it->held = false;
+                it->done = true;
+                it->state = Failed;
+                it->message = tr("a job this one depends on did not succeed");
+                emit jobChanged(it.key());
+                changed = true;
+            } else if(ready) {
+                it->held = false;
+                pool.start(it->job);
+            }
+        }
+    }
+}
+
+void ConversionQueue::evtProgress(int percent, qlonglong features, qlonglong bytes) {
+    const int id = senderId();
+    if(id < 0)
+        return;
+    jobs[id].percent = percent;
+    emit jobProgress(id, percent, features, bytes);
+    emit jobChanged(id);
+}
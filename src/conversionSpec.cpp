@@ -0,0 +1,135 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file conversionSpec.cpp
+ *	\brief Conversion Spec
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "conversionSpec.h"
+#include "cpl_string.h"
+
+QStringList ConversionSpec::options(void) const {
+    QStringList list;
+    list << "-f" << targetFormat;
+    if(!sourceSrs.isEmpty())
+        list << "-s_srs" << "EPSG:" + sourceSrs;
+    if(!targetSrs.isEmpty())
+        list << "-t_srs" << "EPSG:" + targetSrs;
+    if(!sql.isEmpty())
+        list << "-sql" << sql;
+    if(!where.isEmpty())
+        list << "-where" << where;
+    if(overwrite)
+        list << "-overwrite";
+    if(append)
+        list << "-append";
+    if(update)
+        list << "-update";
+    if(skipFailures)
+        list << "-skipfailures";
+    if(!layerName.isEmpty())
+        list << "-nln" << layerName;
+    list << layers;
+    if(spatialFilter.size() == 4)
+        list << "-spat" << spatialFilter;
+    if(!datasetCreationOption.isEmpty())
+        list << "-dsco" << datasetCreationOption;
+    if(!layerCreationOption.isEmpty())
+        list << "-lco" << layerCreationOption;
+    list << extraArguments;
+    return list;
+}
+
+QStringList ConversionSpec::arguments(void) const {
+    QStringList list = options();
+    // the datasources follow -f, as fromArguments reads them back
+    QStringList datasources;
+    if(!target.isEmpty())
+        datasources << target;
+    if(!source.isEmpty())
+        datasources << source;
+    if(!source.isEmpty() && !inputFormat.isEmpty())
+        datasources << "-if" << inputFormat;
+    for(int i = 0; i < datasources.size(); ++i)
+        list.insert(2 + i, datasources.at(i));
+    return list;
+}
+
+ConversionSpec ConversionSpec::fromArguments(const QStringList list) {
+    ConversionSpec spec;
+    if(list.size() < 4 || list.at(0) != "-f") {
+        spec.extraArguments = list;
+        return spec;
+    }
+    spec.targetFormat = list.at(1);
+    spec.target = list.at(2);
+    spec.source = list.at(3);
+    int next = 4;
+    if(list.size() > 5 && list.at(4) == "-if") {
+        spec.inputFormat = list.at(5);
+        next = 6;
+    }
+    spec.extraArguments = list.mid(next);
+    return spec;
+}
+
+QString ConversionSpec::command(void) const {
+    QString command = "ogr2ogr";
+    foreach(QString argument, arguments()) {
+        if(argument.isEmpty() || argument.contains(' ') || argument.contains('"')) {
+            // quoted so CSLTokenizeString gives back the same argument, it only
+            // unescapes a backslash in front of a quote or another backslash
+            QString quoted = "\"";
+            for(int i = 0; i < argument.size(); ++i) {
+                const QChar next = i + 1 < argument.size() ? argument.at(i + 1) : QChar('"');
+                if(argument.at(i) == '"' || (argument.at(i) == '\\' && (next == '"' || next == '\\')))
+                    quoted += '\\';
+                quoted += argument.at(i);
+            }
+            argument = quoted + "\"";
+        }
+        command += " " + argument;
+    }
+    return command;
+}
+
+bool ConversionSpec::isIdempotent(void) const {
+    if(append || extraArguments.contains("-append"))
+        return false;
+    if(overwrite || extraArguments.contains("-overwrite"))
+        return true;
+    return !update && !extraArguments.contains("-update");
+}
+
+QStringList ConversionSpec::tokenize(const QString text) {
+    QStringList list;
+    char **papszTokens = CSLTokenizeString(text.toUtf8().constData());
+    for(int i = 0; i < CSLCount(papszTokens); ++i)
+        list << QString::fromUtf8(papszTokens[i]);
+    CSLDestroy(papszTokens);
+    return list;
+}
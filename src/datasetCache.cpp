@@ -0,0 +1,204 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file datasetCache.cpp
+ *	\brief Dataset Cache
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "datasetCache.h"
+#include "ogr_api.h"
+#include "cpl_vsi.h"
+#include "cpl_error.h"
+#include "cpl_string.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+
+QMutex DatasetCache::instanceMutex;
+DatasetCache* DatasetCache::instance;
+
+static const qint64 CONNECTION_LIFETIME = 60;
+
+DatasetCache::DatasetCache(void) : capacity(8) {
+}
+
+DatasetCache::~DatasetCache(void) {
+    clear();
+}
+
+DatasetCache* DatasetCache::getInstance(void) {
+    QMutexLocker locker(&instanceMutex);
+    if(instance == NULL)
+        instance = new DatasetCache();
+    return instance;
+}
+
+string DatasetCache::normalize(const string name) {
+    const QFileInfo info(QString::fromStdString(name));
+    if(info.exists())
+        return info.canonicalFilePath().toStdString();
+    return name;
+}
+
+QStringList DatasetCache::files(const string name, GDALDatasetH hDS) {
+    QStringList list;
+    VSIStatBufL sStat;
+    if(VSIStatL(name.c_str(), &sStat) != 0)
+        return list;
+    // a folder source changes its time when a layer file is added
+    list << QString::fromStdString(name);
+    char **papszFiles = GDALGetFileList(hDS);
+    for(int i = 0; i < CSLCount(papszFiles); ++i) {
+        if(name != papszFiles[i])
+            list << QString::fromUtf8(papszFiles[i]);
+    }
+    CSLDestroy(papszFiles);
+    return list;
+}
+
+QByteArray DatasetCache::state(const QStringList files) {
+    QByteArray state;
+    foreach(const QString file, files) {
+        VSIStatBufL sStat;
+        if(VSIStatL(file.toUtf8().constData(), &sStat) == 0)
+            state += QByteArray::number(static_cast<qlonglong>(sStat.st_mtime)) + ":" + QByteArray::number(static_cast<qlonglong>(sStat.st_size));
+        state += ";";
+    }
+    return state;
+}
+
+bool DatasetCache::isValid(const Entry &entry) {
+    // connection strings have nothing to stat, tables may change any time
+    if(entry.files.isEmpty())
+        return entry.opened + CONNECTION_LIFETIME > static_cast<qint64>(QDateTime::currentDateTime().toTime_t());
+    return state(entry.files) == entry.state;
+}
+
+GDALDatasetH DatasetCache::acquire(const string name, const string driver) {
+    const string key = normalize(name);
+
+    mutex.lock();
+    for(int i = 0; i < entries.size(); ++i) {
+        if(entries.at(i).inUse || entries.at(i).key != key)
+            continue;
+        // taken out while its files are checked, no one else gets it
+        Entry entry = entries.takeAt(i);
+        mutex.unlock();
+        if(isValid(entry)) {
+            entry.inUse = true;
+            QMutexLocker locker(&mutex);
+            entries.prepend(entry);
+            return entry.hDS;
+        }
+        GDALClose(entry.hDS);
+        mutex.lock();
+        break;
+    }
+    mutex.unlock();
+
+    GDALDatasetH hDS = NULL;
+    if(!driver.empty()) {
+        // every driver probed is a stat or read, slow on network shares
+        const char *const apszAllowedDrivers[] = { driver.c_str(), NULL };
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        hDS = GDALOpenEx(name.c_str(), GDAL_OF_VECTOR, apszAllowedDrivers, NULL, NULL);
+        CPLPopErrorHandler();
+    }
+    if(hDS == NULL)
+        hDS = GDALOpenEx(name.c_str(), GDAL_OF_VECTOR, NULL, NULL, NULL);
+    if(hDS == NULL)
+        return NULL;
+    Entry entry;
+    entry.key = key;
+    entry.hDS = hDS;
+    entry.files = files(name, hDS);
+    entry.state = state(entry.files);
+    entry.opened = QDateTime::currentDateTime().toTime_t();
+    entry.inUse = true;
+    entry.stale = false;
+    QMutexLocker locker(&mutex);
+    entries.prepend(entry);
+    evict();
+    return hDS;
+}
+
+void DatasetCache::release(GDALDatasetH hDS) {
+    if(hDS == NULL)
+        return;
+    QMutexLocker locker(&mutex);
+    for(int i = 0; i < entries.size(); ++i) {
+        if(entries.at(i).hDS != hDS)
+            continue;
+        if(!entries.at(i).inUse)
+            return;
+        if(entries.at(i).stale) {
+            GDALClose(entries.takeAt(i).hDS);
+            return;
+        }
+        for(int j = 0; j < GDALDatasetGetLayerCount(hDS); ++j) {
+            OGRLayerH hLayer = GDALDatasetGetLayer(hDS, j);
+            OGR_L_SetAttributeFilter(hLayer, NULL);
+            OGR_L_SetSpatialFilter(hLayer, NULL);
+            OGR_L_SetIgnoredFields(hLayer, NULL);
+            OGR_L_ResetReading(hLayer);
+        }
+        entries[i].inUse = false;
+        evict();
+        return;
+    }
+}
+
+void DatasetCache::invalidate(const string name) {
+    const string key = normalize(name);
+    QMutexLocker locker(&mutex);
+    for(int i = entries.size() - 1; i >= 0; --i) {
+        if(entries.at(i).key != key)
+            continue;
+        if(entries.at(i).inUse)
+            entries[i].stale = true;
+        else
+            GDALClose(entries.takeAt(i).hDS);
+    }
+}
+
+void DatasetCache::clear(void) {
+    QMutexLocker locker(&mutex);
+    for(int i = entries.size() - 1; i >= 0; --i) {
+        if(!entries.at(i).inUse)
+            GDALClose(entries.takeAt(i).hDS);
+    }
+}
+
+void DatasetCache::evict(void) {
+    int idle = 0;
+    for(int i = 0; i < entries.size(); ++i) {
+        if(entries.at(i).inUse)
+            continue;
+        if(++idle > capacity)
+            GDALClose(entries.takeAt(i--).hDS);
+    }
+}
@@ -33,44 +33,82 @@
 #include "app.h"
 #include "cpl_conv.h"
 #include "i18n.h"
+#include "ogr2ogrEngine.h"
+#include "startupTimer.h"
 #include <iostream>
 #include <QSettings>
 
 int main(int argc, char **argv) {
-    QApplication app(argc, argv);
-    string dataPath = QDir::toNativeSeparators(QCoreApplication::applicationDirPath() + QDir::separator() + "data").toStdString();
-    CPLSetConfigOption("GDAL_DATA", dataPath.c_str());
     if(1 < argc) {
+        // command line mode, used by the process backend: no display needed
+        QCoreApplication app(argc, argv);
+        string dataPath = QDir::toNativeSeparators(QCoreApplication::applicationDirPath() + QDir::separator() + "data").toStdString();
+        CPLSetConfigOption("GDAL_DATA", dataPath.c_str());
         for(int i=0;i<argc;++i)
             std::cout << argv[i] << " ";
         std::cout << std::endl;
-        return ogr2ogr(argc, argv);
-    } else {
-        QSettings settings("ogr2gui.ini", QSettings::IniFormat);
-        QVariant language = settings.value("language");
-        if(language.isNull() || !language.isValid()) {
-            settings.setValue("language", "en_GB");
-            language = "en_GB";
-        }
-        QList<QString> gcspcsList;
-        gcspcsList << "gcs" << "pcs";
-        for(int i = 0; i < gcspcsList.size(); ++i) {
-            QVariant gcspcs = settings.value(gcspcsList.at(i));
-            if(gcspcs.isNull() || !gcspcs.isValid()) {
-                settings.setValue(gcspcsList.at(i), "true");
-            }
+        QStringList arguments = app.arguments();
+        arguments.removeFirst();
+        GDALAllRegister();
+        Ogr2ogrEngine engine;
+        engine.setProgress(GDALTermProgress, NULL);
+        const bool resVal = engine.translate(ConversionSpec::fromArguments(arguments));
+        if(!engine.getError().empty())
+            std::cerr << engine.getError() << std::endl;
+        return resVal ? 0 : 1;
+    }
+    StartupTimer::start();
+    StartupTimer::begin("application");
+    QApplication app(argc, argv);
+    StartupTimer::end("application");
+    StartupTimer::begin("defaults");
+    string dataPath = QDir::toNativeSeparators(QCoreApplication::applicationDirPath() + QDir::separator() + "data").toStdString();
+    CPLSetConfigOption("GDAL_DATA", dataPath.c_str());
+    QSettings settings("ogr2gui.ini", QSettings::IniFormat);
+    QVariant language = settings.value("language");
+    if(language.isNull() || !language.isValid()) {
+        settings.setValue("language", "en_GB");
+        language = "en_GB";
+    }
+    QList<QString> gcspcsList;
+    gcspcsList << "gcs" << "pcs";
+    for(int i = 0; i < gcspcsList.size(); ++i) {
+        QVariant gcspcs = settings.value(gcspcsList.at(i));
+        if(gcspcs.isNull() || !gcspcs.isValid()) {
+            settings.setValue(gcspcsList.at(i), "true");
         }
-        QList<QString> gcspcsoverrideList;
-        gcspcsoverrideList << "gcsoverride" << "pcsoverride";
-        for(int i = 0; i < gcspcsoverrideList.size(); ++i) {
-            QVariant gcspcsoverride = settings.value(gcspcsoverrideList.at(i));
-            if(gcspcsoverride.isNull() || !gcspcsoverride.isValid()) {
-                settings.setValue(gcspcsoverrideList.at(i), "false");
-            }
+    }
+    QList<QString> gcspcsoverrideList;
+    gcspcsoverrideList << "gcsoverride" << "pcsoverride" << "process" << "splitlayers" << "batch";
+    for(int i = 0; i < gcspcsoverrideList.size(); ++i) {
+        QVariant gcspcsoverride = settings.value(gcspcsoverrideList.at(i));
+        if(gcspcsoverride.isNull() || !gcspcsoverride.isValid()) {
+            settings.setValue(gcspcsoverrideList.at(i), "false");
         }
-        I18N *i18n = I18N::getInstance();
-        i18n->translate(language.toString());
-        new App();
     }
+    QVariant threads = settings.value("threads");
+    if(threads.isNull() || !threads.isValid()) {
+        settings.setValue("threads", qMax(1, QThread::idealThreadCount()));
+    }
+    QVariant shards = settings.value("shards");
+    if(shards.isNull() || !shards.isValid()) {
+        settings.setValue("shards", 1);
+    }
+    QVariant samples = settings.value("samples");
+    if(samples.isNull() || !samples.isValid()) {
+        settings.setValue("samples", 1000);
+    }
+    QVariant retries = settings.value("retries");
+    if(retries.isNull() || !retries.isValid()) {
+        settings.setValue("retries", 0);
+    }
+    StartupTimer::end("defaults");
+    StartupTimer::begin("translate");
+    I18N *i18n = I18N::getInstance();
+    i18n->translate(language.toString());
+    StartupTimer::end("translate");
+    StartupTimer::begin("window");
+    new App();
+    StartupTimer::end("window");
     return app.exec();
 }
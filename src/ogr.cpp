@@ -31,80 +31,26 @@
  */
 
 #include "ogr.h"
-#include <QtCore/QSysInfo>
-#include <windows.h>
+#include "cpl_string.h"
 
-typedef enum { Win_64, Win_32, WOW64, Error, Other } OsType;
-
-typedef BOOL (WINAPI *LPFN_ISWOW64PROCESS) (HANDLE, PBOOL);
-
-OsType checkOS() {
-#ifndef Q_OS_WIN32
-    return Other;
-#else
-    if (QSysInfo::WordSize == 64)
-        return Win_64;
-    BOOL isWOW64 = FALSE;
-    LPFN_ISWOW64PROCESS fnIsWow64Process;
-    fnIsWow64Process = (LPFN_ISWOW64PROCESS) GetProcAddress(GetModuleHandle(TEXT("kernel32")),"IsWow64Process");
-    if(fnIsWow64Process == NULL)
-        return Win_32;
-    if(!IsWow64Process(GetCurrentProcess(), &isWOW64))
-        return Error;
-    return isWOW64? WOW64 : Win_32;
-#endif
-}
-
-Ogr::Ogr(void) {
-    OGRRegisterAll();
+Ogr::Ogr(void) : sourceData(NULL), sourceLayer(NULL), targetSRS(NULL), targetEPSG(0), transformation(NULL) {
 }
 
 Ogr::~Ogr(void) {
 }
 
-bool Ogr::openOgr2ogr(QString command, QPushButton *btnConvert) {
-    bool resVal = false;
-    if(checkOS() == Win_64) {
-        ogr2ogr = new Ogr2ogrThread(command, btnConvert);
-        ogr2ogr->start();
-        resVal = ogr2ogr->isRunning();
-    } else if(checkOS() == WOW64) {
-        const QString logPath = QDir::toNativeSeparators(QCoreApplication::applicationDirPath() + QDir::separator() + "ogr2ogr.log");
-        btnConvert->setEnabled(false);
-        process = new QProcess();
-        process->setProcessChannelMode(QProcess::MergedChannels);
-        process->setStandardOutputFile(logPath);
-        process->start(command);
-        resVal = process->waitForFinished(-1);
-        btnConvert->setEnabled(true);
-    } else if(checkOS() == Win_32){
-        std::string cmd = command.toStdString();
-        std::wstring widestring = std::wstring(cmd.begin(), cmd.end());
-        LPWSTR lpwstr = const_cast<LPWSTR>(widestring.c_str());
-        STARTUPINFO si;
-        PROCESS_INFORMATION pi;
-        ZeroMemory(&si, sizeof(si));
-        si.cb = sizeof(si);
-        ZeroMemory(&pi, sizeof(pi));
-        resVal = CreateProcess(NULL, lpwstr, 0, 0, FALSE, CREATE_NO_WINDOW, 0, 0, &si, &pi);
-        WaitForSingleObject(pi.hProcess, INFINITE);
-        CloseHandle(pi.hProcess);
-        CloseHandle(pi.hThread);
-    }
-    return resVal;
-}
-
 bool Ogr::openWFS(const QString uri, QStringList &fileList) {
     sourceName = uri.toStdString();
-    OGRDataSourceH sourceData = OGROpen(sourceName.c_str(), 0, NULL);
+    GDALDatasetH sourceData = DatasetCache::getInstance()->acquire(sourceName, "WFS");
     if(sourceData != NULL) {
-        for(int i = 0; i < OGR_DS_GetLayerCount(sourceData); ++i) {
-            OGRLayerH sourceLayer = OGR_DS_GetLayer(sourceData, i);
+        for(int i = 0; i < GDALDatasetGetLayerCount(sourceData); ++i) {
+            OGRLayerH sourceLayer = GDALDatasetGetLayer(sourceData, i);
             if(sourceLayer != NULL) {
                 OGRFeatureDefnH sourceLayerDefn = OGR_L_GetLayerDefn(sourceLayer);
                 fileList.append(OGR_FD_GetName(sourceLayerDefn));
             }
         }
+        DatasetCache::getInstance()->release(sourceData);
         return true;
     }
     return false;
@@ -116,9 +62,10 @@ bool Ogr::openSource(const string filename, const string layername, string &epsg
 }
 
 bool Ogr::openSource(const string filename, string &epsg, string &query, string &error) {
+    closeSource();
     sourceSRS = NULL;
     sourceName = filename;
-    sourceData = OGROpen(sourceName.c_str(), 0, NULL);
+    sourceData = static_cast<OGRDataSourceH>(DatasetCache::getInstance()->acquire(sourceName, sourceFormat));
     if(sourceData != NULL) {
         if(layerName != "")
             sourceLayer = OGR_DS_GetLayerByName(sourceData, layerName.c_str());
@@ -137,6 +84,7 @@ bool Ogr::openSource(const string filename, string &epsg, string &query, string
                 query = "SELECT * FROM " + sourceLayerName;
             }
         } else {
+            closeSource();
             return false;
         }
     } else {
@@ -145,14 +93,77 @@ bool Ogr::openSource(const string filename, string &epsg, string &query, string
     return true;
 }
 
-bool Ogr::closeSource(void) const {
+bool Ogr::closeSource(void) {
     if(sourceData != NULL) {
-        OGR_DS_Destroy(sourceData);
+        DatasetCache::getInstance()->release(static_cast<GDALDatasetH>(sourceData));
+        sourceData = NULL;
+        sourceLayer = NULL;
         return true;
     }
     return false;
 }
 
+void Ogr::setSourceFormat(const string format) {
+    sourceFormat = format;
+}
+
+int Ogr::getSourceLayerCount(void) const {
+    return sourceData != NULL ? OGR_DS_GetLayerCount(sourceData) : 0;
+}
+
+string Ogr::getSourceLayerName(void) const {
+    return sourceLayerName;
+}
+
+GIntBig Ogr::getSourceFeatureCount(void) const {
+    return sourceLayer != NULL ? OGR_L_GetFeatureCount(sourceLayer, TRUE) : -1;
+}
+
+QList<LayerInfo> Ogr::getSourceLayers(void) const {
+    QList<LayerInfo> layers;
+    if(sourceData == NULL)
+        return layers;
+    for(int i = 0; i < OGR_DS_GetLayerCount(sourceData); ++i) {
+        OGRLayerH layer = OGR_DS_GetLayer(sourceData, i);
+        if(layer == NULL)
+            continue;
+        OGRFeatureDefnH layerDefn = OGR_L_GetLayerDefn(layer);
+        LayerInfo info;
+        info.name = OGR_FD_GetName(layerDefn);
+        info.geometry = OGRGeometryTypeToName(OGR_FD_GetGeomType(layerDefn));
+        OGRSpatialReferenceH srs = OGR_L_GetSpatialRef(layer);
+        if(srs != NULL && OSRAutoIdentifyEPSG(srs) == OGRERR_NONE && OSRGetAttrValue(srs, "AUTHORITY", 1) != NULL)
+            info.epsg = OSRGetAttrValue(srs, "AUTHORITY", 1);
+        QStringList fields;
+        for(int j = 0; j < OGR_FD_GetFieldCount(layerDefn); ++j) {
+            OGRFieldDefnH fieldDefn = OGR_FD_GetFieldDefn(layerDefn, j);
+            fields << QString(OGR_Fld_GetNameRef(fieldDefn)) + " " + OGR_GetFieldTypeName(OGR_Fld_GetType(fieldDefn));
+        }
+        info.fields = fields.join(", ");
+        OGREnvelope extent;
+        if(OGR_L_GetExtent(layer, &extent, FALSE) == OGRERR_NONE) {
+            info.minX = extent.MinX;
+            info.minY = extent.MinY;
+            info.maxX = extent.MaxX;
+            info.maxY = extent.MaxY;
+        }
+        info.features = OGR_L_GetFeatureCount(layer, FALSE);
+        layers.append(info);
+    }
+    return layers;
+}
+
+QStringList Ogr::getSourceFiles(void) const {
+    QStringList files;
+    if(sourceData == NULL)
+        return files;
+    char **papszFiles = GDALGetFileList(static_cast<GDALDatasetH>(sourceData));
+    for(int i = 0; i < CSLCount(papszFiles); ++i)
+        files << QString::fromUtf8(papszFiles[i]);
+    CSLDestroy(papszFiles);
+    return files;
+}
+
 bool Ogr::openDriver(const string drivername) {
     formatDriver = OGRGetDriverByName(drivername.c_str());
     return formatDriver != NULL;
@@ -160,32 +171,110 @@ bool Ogr::openDriver(const string drivername) {
 
 bool Ogr::testSpatialReference(const int projection) {
     targetSRS = NULL;
+    targetEPSG = projection;
     if(projection > 0) {
-        targetSRS = OSRNewSpatialReference(NULL);
-        if(Error(OSRImportFromEPSG(targetSRS, projection), error)) {
+        // shared by all instances, imported once per code
+        OGRErr eErr = OGRERR_NONE;
+        targetSRS = SrsCache::getInstance()->get(projection, &eErr);
+        if(Error(eErr, error)) {
             return false;
         }
     }
     return true;
 }
 
-bool Ogr::testFeatureProjection(void) {
+bool Ogr::testFeatureProjection(const int sample) {
+    if(targetSRS == NULL || sourceLayer == NULL)
+        return true;
+    // one transformation for the layer instead of one per geometry
+    transformation = SrsCache::getInstance()->acquire(sourceSRS, targetEPSG);
+    const bool resVal = testFeatureSample(sample);
+    SrsCache::getInstance()->release(transformation);
+    transformation = NULL;
+    return resVal;
+}
+
+bool Ogr::testFeatureSample(const int sample) {
+    OGREnvelope extent;
+    if(sourceSRS != NULL && OGR_L_GetExtent(sourceLayer, &extent, FALSE) == OGRERR_NONE) {
+        if(transformation == NULL)
+            return !Error(OGRERR_FAILURE, error);
+        const double corners[4][2] = {
+            {extent.MinX, extent.MinY}, {extent.MinX, extent.MaxY},
+            {extent.MaxX, extent.MinY}, {extent.MaxX, extent.MaxY}
+        };
+        for(int i = 0; i < 4; ++i) {
+            OGRGeometryH point = OGR_G_CreateGeometry(wkbPoint);
+            OGR_G_SetPoint_2D(point, 0, corners[i][0], corners[i][1]);
+            const bool failed = Error(OGR_G_Transform(point, transformation), error);
+            OGR_G_DestroyGeometry(point);
+            if(failed)
+                return false;
+        }
+    }
+    // features are transformed in batches, see TransformBatch
+    QList<OGRFeatureH> features;
+    const GIntBig count = OGR_L_GetFeatureCount(sourceLayer, FALSE);
+    if(sample > 0 && count > sample && OGR_L_TestCapability(sourceLayer, OLCRandomRead)) {
+        // features spread evenly over the FID range, missing FIDs are skipped
+        for(int i = 0; i < sample; ++i) {
+            OGRFeatureH feature = OGR_L_GetFeature(sourceLayer, static_cast<GIntBig>(i) * count / sample);
+            if(feature != NULL)
+                features.append(feature);
+            if(features.size() >= batchSize && !testFeatures(features))
+                return false;
+        }
+        return testFeatures(features);
+    }
     OGR_L_ResetReading(sourceLayer);
     OGRFeatureH feature;
-    while((feature = OGR_L_GetNextFeature(sourceLayer)) != NULL) {
-        if(targetSRS)
-            if(Error(OGR_G_TransformTo(OGR_F_GetGeometryRef(feature), targetSRS), error)) {
-                OGR_F_Destroy(feature);
-                return false;
-            }
-        OGR_F_Destroy(feature);
+    for(int i = 0; (sample <= 0 || i < sample) && (feature = OGR_L_GetNextFeature(sourceLayer)) != NULL; ++i) {
+        features.append(feature);
+        if(features.size() >= batchSize && !testFeatures(features))
+            return false;
     }
-    return true;
+    return testFeatures(features);
+}
+
+bool Ogr::testFeatures(QList<OGRFeatureH> &features) {
+    TransformBatch batch(transformation, sourceSRS, targetSRS);
+    bool failed = false;
+    foreach(OGRFeatureH feature, features) {
+        OGRGeometryH geometry = OGR_F_GetGeometryRef(feature);
+        if(geometry == NULL || failed)
+            continue;
+        // geometries of another reference than their layer are rare, they
+        // get a transformation of their own
+        if(transformation != NULL && OGR_G_GetSpatialReference(geometry) == sourceSRS)
+            batch.add(geometry);
+        else
+            failed = Error(OGR_G_TransformTo(geometry, targetSRS), error);
+    }
+    if(!failed)
+        failed = Error(batch.flush(), error);
+    foreach(OGRFeatureH feature, features)
+        OGR_F_Destroy(feature);
+    features.clear();
+    return !failed;
 }
 
 bool Ogr::testExecuteSQL(const string query) const {
-    OGRLayerH squeryLayer = OGR_DS_ExecuteSQL(sourceData, query.c_str(), NULL, "");
-    return squeryLayer != NULL;
+    if(sourceData == NULL)
+        return false;
+    string statement = query;
+    const string driver = GDALGetDriverShortName(GDALGetDatasetDriver(sourceData));
+    if(driver == "PostgreSQL" || driver == "MySQL" || driver == "SQLite" || driver == "GPKG") {
+        // the server would run the whole query, sorting and joining included
+        const size_t end = statement.find_last_not_of(" \t\r\n;");
+        statement = "SELECT * FROM (" + statement.substr(0, end == string::npos ? 0 : end + 1) + ") AS ogr2gui_check LIMIT 0";
+    }
+    // OGR SQL sorts and aggregates on the first read, the result is never read here
+    OGRLayerH squeryLayer = OGR_DS_ExecuteSQL(sourceData, statement.c_str(), NULL, "");
+    if(squeryLayer == NULL)
+        return false;
+    // the handle is cached, result sets must not outlive the test
+    OGR_DS_ReleaseResultSet(sourceData, squeryLayer);
+    return true;
 }
 
 bool Ogr::Error(OGRErr code, string &type)
@@ -0,0 +1,359 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file ogr2ogrEngine.cpp
+ *	\brief In-process ogr2ogr
+ *	\author David Tran
+ *	\version 0.8
+ */
+
+#include "ogr2ogrEngine.h"
+#include "ogr_api.h"
+#include "datasetCache.h"
+#include "srsCache.h"
+#include "transformDataset.h"
+
+#include <QVector>
+
+Ogr2ogrEngine::Ogr2ogrEngine(void) : featureCount(-1), pfnProgress(NULL), pProgressArg(NULL), hTransactionDS(NULL), interrupted(false), cancelled(0), paused(0) {
+}
+
+Ogr2ogrEngine::~Ogr2ogrEngine(void) {
+}
+
+void CPL_STDCALL Ogr2ogrEngine::errorHandler(CPLErr eErr, CPLErrorNum, const char *pszMessage) {
+    Ogr2ogrEngine *engine = static_cast<Ogr2ogrEngine*>(CPLGetErrorHandlerUserData());
+    if(engine == NULL || eErr == CE_Debug)
+        return;
+    if(!engine->error.empty())
+        engine->error += "\n";
+    engine->error += (eErr == CE_Warning ? "Warning: " : "ERROR: ");
+    engine->error += pszMessage;
+}
+
+int CPL_STDCALL Ogr2ogrEngine::progress(double dfComplete, const char *pszMessage, void *pProgressArg) {
+    Ogr2ogrEngine *engine = static_cast<Ogr2ogrEngine*>(pProgressArg);
+    if(!proceed(engine))
+        return FALSE;
+    if(engine->pfnProgress != NULL)
+        return engine->pfnProgress(dfComplete, pszMessage, engine->pProgressArg);
+    return TRUE;
+}
+
+bool Ogr2ogrEngine::proceed(void *pContinueArg) {
+    Ogr2ogrEngine *engine = static_cast<Ogr2ogrEngine*>(pContinueArg);
+    if(engine->paused.load()) {
+        engine->pauseMutex.lock();
+        while(engine->paused.load() && !engine->cancelled.load())
+            engine->pauseCondition.wait(&engine->pauseMutex);
+        engine->pauseMutex.unlock();
+    }
+    if(!engine->cancelled.load())
+        return true;
+    if(!engine->interrupted) {
+        engine->interrupted = true;
+        // ogr2ogr commits once the reading ends, the transaction it holds on
+        // an existing target is undone while still open
+        if(engine->hTransactionDS != NULL) {
+            CPLPushErrorHandler(CPLQuietErrorHandler);
+            GDALDatasetRollbackTransaction(engine->hTransactionDS);
+            CPLPopErrorHandler();
+        }
+    }
+    return false;
+}
+
+GIntBig Ogr2ogrEngine::countFeatures(GDALDatasetH hDS, const QStringList layers) {
+    QVector<OGRLayerH> translated;
+    if(layers.isEmpty()) {
+        for(int i = 0; i < GDALDatasetGetLayerCount(hDS); ++i)
+            translated.append(GDALDatasetGetLayer(hDS, i));
+    } else {
+        foreach(const QString layer, layers) {
+            OGRLayerH hLayer = GDALDatasetGetLayerByName(hDS, layer.toUtf8().constData());
+            if(hLayer != NULL)
+                translated.append(hLayer);
+        }
+    }
+    GIntBig featureCount = 0;
+    foreach(OGRLayerH hLayer, translated) {
+        const GIntBig count = OGR_L_GetFeatureCount(hLayer, FALSE);
+        if(count < 0)
+            return -1;
+        featureCount += count;
+    }
+    return featureCount;
+}
+
+int Ogr2ogrEngine::batchedTarget(char **papszArguments) {
+    const int index = CSLFindString(papszArguments, "-t_srs");
+    if(index < 0 || papszArguments[index + 1] == NULL || !STARTS_WITH_CI(papszArguments[index + 1], "EPSG:"))
+        return 0;
+    const char *pszCode = papszArguments[index + 1] + 5;
+    if(*pszCode == '\0' || strspn(pszCode, "0123456789") != strlen(pszCode))
+        return 0;
+    // ogr2ogr applies these before reprojecting, or reads the source itself
+    const char *const apszSourceOptions[] = {
+        "-s_srs", "-a_srs", "-sql", "-dialect", "-spat_srs", "-geomfield", "-clipsrc", "-clipsrcsql",
+        "-clipsrclayer", "-clipsrcwhere", "-segmentize", "-simplify", "-zfield", "-dim", "-gcp",
+        "-order", "-tps", "-wrapdateline", "-datelineoffset", NULL
+    };
+    for(int i = 0; apszSourceOptions[i] != NULL; ++i) {
+        if(CSLFindString(papszArguments, apszSourceOptions[i]) >= 0)
+            return 0;
+    }
+    const int geometryType = CSLFindString(papszArguments, "-nlt");
+    if(geometryType >= 0 && papszArguments[geometryType + 1] != NULL && STARTS_WITH_CI(papszArguments[geometryType + 1], "CONVERT_TO_"))
+        return 0;
+    return atoi(pszCode);
+}
+
+bool Ogr2ogrEngine::translate(const ConversionSpec &spec) {
+    error.clear();
+    target.clear();
+    featureCount = -1;
+    interrupted = false;
+    const QByteArray source = spec.source.toUtf8();
+    const QByteArray destination = spec.target.toUtf8();
+    if(source.isEmpty()) {
+        error = "no source datasource provided";
+        return false;
+    }
+    if(destination.isEmpty()) {
+        error = "no target datasource provided";
+        return false;
+    }
+    const QByteArray format = spec.targetFormat.isEmpty() ? QByteArray("ESRI Shapefile") : spec.targetFormat.toUtf8();
+    const string inputFormat = spec.inputFormat.toStdString();
+
+    // the datasources are passed to GDALVectorTranslate directly, the options
+    // for the binary have the struct layout of one GDAL version only
+    char **papszArguments = NULL;
+    foreach(const QString argument, spec.options())
+        papszArguments = CSLAddString(papszArguments, argument.toUtf8().constData());
+    // GDALVectorTranslate only calls the progress callback, and thus checks
+    // the cancel/pause token, with -progress
+    if(CSLFindString(papszArguments, "-progress") < 0)
+        papszArguments = CSLAddString(papszArguments, "-progress");
+    // without the options for the binary, -oo is dropped by GDAL
+    char **papszOpenOptions = NULL;
+    int openOptionIndex;
+    while((openOptionIndex = CSLFindString(papszArguments, "-oo")) >= 0 && papszArguments[openOptionIndex + 1] != NULL) {
+        papszOpenOptions = CSLAddString(papszOpenOptions, papszArguments[openOptionIndex + 1]);
+        papszArguments = CSLRemoveStrings(papszArguments, openOptionIndex, 2, NULL);
+    }
+    // -append, -overwrite and -addfields open the target for update as well
+    const bool creation = CSLFindString(papszArguments, "-update") < 0 && CSLFindString(papszArguments, "-append") < 0 &&
+            CSLFindString(papszArguments, "-overwrite") < 0 && CSLFindString(papszArguments, "-addfields") < 0;
+    const bool destinationOpenOptions = CSLFindString(papszArguments, "-doo") >= 0;
+    const int batchTarget = batchedTarget(papszArguments);
+    const bool skipFailures = CSLFindString(papszArguments, "-skipfailures") >= 0;
+    // the fast count of the source layers says nothing about these
+    const bool filtered = CSLFindString(papszArguments, "-where") >= 0 || CSLFindString(papszArguments, "-spat") >= 0 ||
+            CSLFindString(papszArguments, "-fid") >= 0 || CSLFindString(papszArguments, "-sql") >= 0 ||
+            CSLFindString(papszArguments, "-clipsrc") >= 0 || CSLFindString(papszArguments, "-clipdst") >= 0;
+    // EPSG codes are looked up in the data/*.csv tables on every job, the
+    // cached definition is parsed without them
+    const char *const apszSrsOptions[] = { "-s_srs", "-t_srs", "-a_srs", NULL };
+    for(int i = 0; apszSrsOptions[i] != NULL; ++i) {
+        const int index = CSLFindString(papszArguments, apszSrsOptions[i]);
+        if(index < 0 || papszArguments[index + 1] == NULL || !STARTS_WITH_CI(papszArguments[index + 1], "EPSG:"))
+            continue;
+        // compound codes like EPSG:4326+5773 are left to GDAL
+        const char *pszCode = papszArguments[index + 1] + 5;
+        if(*pszCode == '\0' || strspn(pszCode, "0123456789") != strlen(pszCode))
+            continue;
+        const string wkt = SrsCache::getInstance()->wkt(atoi(pszCode));
+        if(!wkt.empty()) {
+            CPLFree(papszArguments[index + 1]);
+            papszArguments[index + 1] = CPLStrdup(wkt.c_str());
+        }
+    }
+
+    // drivers are registered once by Ogr, the engine never calls OGRCleanupAll
+    CPLPushErrorHandlerEx(errorHandler, this);
+    GDALVectorTranslateOptions *psOptions = GDALVectorTranslateOptionsNew(papszArguments, NULL);
+    // the features arrive reprojected, ogr2ogr only assigns the target
+    GDALVectorTranslateOptions *psBatchedOptions = NULL;
+    if(batchTarget > 0 && psOptions != NULL) {
+        const int index = CSLFindString(papszArguments, "-t_srs");
+        CPLFree(papszArguments[index]);
+        papszArguments[index] = CPLStrdup("-a_srs");
+        psBatchedOptions = GDALVectorTranslateOptionsNew(papszArguments, NULL);
+    }
+    CSLDestroy(papszArguments);
+
+    GDALDatasetH hDS = NULL;
+    GDALDatasetH hODS = NULL;
+    GDALDatasetH hDstDS = NULL;
+    bool cachedDS = false;
+    bool closeODS = true;
+    bool created = false;
+    bool transformFailed = false;
+    int usageError = FALSE;
+
+    if(psOptions == NULL) {
+        if(error.empty())
+            error = "invalid ogr2ogr arguments";
+    } else {
+        // read handles of the target would not see what is written, they
+        // are dropped before and after the job, those in use on release
+        DatasetCache::getInstance()->invalidate(destination.constData());
+        // same datasource as input and output, as in the ogr2ogr binary
+        if(!creation && destination == source) {
+            hODS = GDALOpenEx(source.constData(), GDAL_OF_UPDATE | GDAL_OF_VECTOR, NULL, papszOpenOptions, NULL);
+            GDALDriverH hDriver = NULL;
+            if(hODS != NULL)
+                hDriver = GDALGetDatasetDriver(hODS);
+            if(hDriver && !(EQUAL(GDALGetDescription(hDriver), "FileGDB") ||
+                            EQUAL(GDALGetDescription(hDriver), "SQLite") ||
+                            EQUAL(GDALGetDescription(hDriver), "GPKG"))) {
+                hDS = GDALOpenEx(source.constData(), GDAL_OF_VECTOR, NULL, papszOpenOptions, NULL);
+            } else {
+                hDS = hODS;
+                closeODS = false;
+            }
+        } else {
+            // open options are not part of the cache key
+            cachedDS = papszOpenOptions == NULL;
+            if(cachedDS)
+                hDS = DatasetCache::getInstance()->acquire(source.constData(), inputFormat);
+            else
+                hDS = GDALOpenEx(source.constData(), GDAL_OF_VECTOR, NULL, papszOpenOptions, NULL);
+            // keep the target handle to roll back its transaction on cancel,
+            // see proceed
+            if(!creation && !destinationOpenOptions)
+                hODS = GDALOpenEx(destination.constData(), GDAL_OF_UPDATE | GDAL_OF_VECTOR, NULL, NULL, NULL);
+        }
+        if(creation) {
+            VSIStatBufL sStat;
+            created = VSIStatL(destination.constData(), &sStat) != 0;
+        }
+        if(hDS == NULL) {
+            if(error.empty())
+                error = string("unable to open datasource ") + source.constData();
+        } else {
+            target = destination.constData();
+            if(!filtered)
+                featureCount = countFeatures(hDS, spec.layers);
+            // reprojected in batches by the source wrapper instead of one
+            // geometry at a time by ogr2ogr
+            GDALVectorTranslateOptions *psTranslateOptions = psOptions;
+            TransformDataset *poTransformDS = NULL;
+            if(psBatchedOptions != NULL && hODS != hDS)
+                poTransformDS = TransformDataset::create(hDS, batchTarget, skipFailures, proceed, this);
+            if(poTransformDS != NULL)
+                psTranslateOptions = psBatchedOptions;
+            // ogr2ogr turns the progress off for layers without a fast
+            // feature count, the wrapper checks the token on every feature
+            else if(hODS != hDS)
+                poTransformDS = TransformDataset::create(hDS, 0, skipFailures, proceed, this);
+            GDALDatasetH hSrcDS = poTransformDS != NULL ? static_cast<GDALDatasetH>(poTransformDS) : hDS;
+            hTransactionDS = hODS;
+            GDALVectorTranslateOptionsSetProgress(psTranslateOptions, progress, this);
+            hDstDS = GDALVectorTranslate(destination.constData(), hODS, 1, &hSrcDS, psTranslateOptions, &usageError);
+            hTransactionDS = NULL;
+            DatasetCache::getInstance()->invalidate(destination.constData());
+            if(poTransformDS != NULL) {
+                transformFailed = poTransformDS->isFailed();
+                delete poTransformDS;
+            }
+            if(usageError && error.empty())
+                error = "invalid ogr2ogr arguments";
+        }
+    }
+
+    // a cancel arriving after the last feature leaves the job succeeded
+    const bool resVal = hDstDS != NULL && !usageError && !transformFailed && !interrupted;
+
+    if(psOptions != NULL)
+        GDALVectorTranslateOptionsFree(psOptions);
+    if(psBatchedOptions != NULL)
+        GDALVectorTranslateOptionsFree(psBatchedOptions);
+    CSLDestroy(papszOpenOptions);
+
+    if(cachedDS)
+        DatasetCache::getInstance()->release(hDS);
+    else if(hDS != NULL)
+        GDALClose(hDS);
+    if(closeODS && hDstDS != NULL)
+        GDALClose(hDstDS);
+    else if(closeODS && hODS != NULL)
+        GDALClose(hODS);
+
+    if(interrupted) {
+        error = "cancelled by user";
+        // the reading ended early, ogr2ogr returns the target as complete
+        if(created) {
+            VSIStatBufL sStat;
+            GDALDriverH hDriver = GDALGetDriverByName(format.constData());
+            CPLPushErrorHandler(CPLQuietErrorHandler);
+            if(hDriver != NULL && VSIStatL(destination.constData(), &sStat) == 0)
+                GDALDeleteDataset(hDriver, destination.constData());
+            CPLPopErrorHandler();
+        }
+    }
+    CPLPopErrorHandler();
+    return resVal;
+}
+
+void Ogr2ogrEngine::setProgress(GDALProgressFunc pfnProgress, void *pProgressArg) {
+    this->pfnProgress = pfnProgress;
+    this->pProgressArg = pProgressArg;
+}
+
+void Ogr2ogrEngine::cancel(void) {
+    pauseMutex.lock();
+    cancelled.store(1);
+    pauseCondition.wakeAll();
+    pauseMutex.unlock();
+}
+
+void Ogr2ogrEngine::pause(void) {
+    paused.store(1);
+}
+
+void Ogr2ogrEngine::resume(void) {
+    pauseMutex.lock();
+    paused.store(0);
+    pauseCondition.wakeAll();
+    pauseMutex.unlock();
+}
+
+bool Ogr2ogrEngine::isCancelled(void) const {
+    return cancelled.load() != 0;
+}
+
+GIntBig Ogr2ogrEngine::getFeatureCount(void) const {
+    return featureCount;
+}
+
+string Ogr2ogrEngine::getTarget(void) const {
+    return target;
+}
+
+string Ogr2ogrEngine::getError(void) const {
+    return error;
+}
@@ -0,0 +1,150 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file ogr2ogrJob.cpp
+ *	\brief ogr2ogr Job
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "ogr2ogrJob.h"
+#include "cpl_vsi.h"
+
+#include <QEventLoop>
+
+QMutex Ogr2ogrJob::logMutex;
+
+Ogr2ogrJob::Ogr2ogrJob(const int id, const QString name, const ConversionSpec spec, const bool separateProcess) :
+    id(id), name(name), spec(spec), command(spec.command()), separateProcess(separateProcess), process(NULL), percent(-1), processResult(false) {
+    setAutoDelete(false);
+    engine.setProgress(progress, this);
+}
+
+Ogr2ogrJob::~Ogr2ogrJob(void) {
+}
+
+void Ogr2ogrJob::cancel(void) {
+    engine.cancel();
+    QMutexLocker locker(&processMutex);
+    if(process != NULL)
+        QMetaObject::invokeMethod(process, "cancel", Qt::QueuedConnection);
+}
+
+bool Ogr2ogrJob::pause(const bool enable) {
+    QMutexLocker locker(&processMutex);
+    if(process != NULL)
+        return process->pause(enable);
+    if(enable)
+        engine.pause();
+    else
+        engine.resume();
+    return true;
+}
+
+int Ogr2ogrJob::getId(void) const {
+    return id;
+}
+
+QString Ogr2ogrJob::getName(void) const {
+    return name;
+}
+
+QString Ogr2ogrJob::getCommand(void) const {
+    return command;
+}
+
+int CPL_STDCALL Ogr2ogrJob::progress(double dfComplete, const char *, void *pProgressArg) {
+    Ogr2ogrJob *job = static_cast<Ogr2ogrJob*>(pProgressArg);
+    const int current = static_cast<int>(dfComplete * 100);
+    // throttle the queued signals: on every percent, or twice per second
+    if(current == job->percent && job->timer.elapsed() < 500)
+        return TRUE;
+    job->percent = current;
+    job->timer.restart();
+    qlonglong features = -1;
+    if(job->engine.getFeatureCount() >= 0)
+        features = static_cast<qlonglong>(dfComplete * job->engine.getFeatureCount());
+    qlonglong bytes = -1;
+    VSIStatBufL sStat;
+    if(VSIStatL(job->engine.getTarget().c_str(), &sStat) == 0 && VSI_ISREG(sStat.st_mode))
+        bytes = sStat.st_size;
+    emit job->progressChanged(current, features, bytes);
+    return TRUE;
+}
+
+void Ogr2ogrJob::evtProcessTranslated(bool success, QString error) {
+    processResult = success;
+    processError = error;
+}
+
+bool Ogr2ogrJob::runProcess(QString &error) {
+    QEventLoop loop;
+    Ogr2ogrProcess *child = new Ogr2ogrProcess(spec);
+    QObject::connect(child, SIGNAL(progressChanged(int, qlonglong, qlonglong)), this, SIGNAL(progressChanged(int, qlonglong, qlonglong)), Qt::DirectConnection);
+    QObject::connect(child, SIGNAL(translated(bool, QString)), this, SLOT(evtProcessTranslated(bool, QString)), Qt::DirectConnection);
+    QObject::connect(child, SIGNAL(translated(bool, QString)), &loop, SLOT(quit()));
+    processMutex.lock();
+    process = child;
+    processMutex.unlock();
+    child->start();
+    loop.exec();
+    processMutex.lock();
+    process = NULL;
+    processMutex.unlock();
+    appendLog(command.toUtf8() + "\n" + child->getTranscript());
+    delete child;
+    error = processError;
+    return processResult;
+}
+
+void Ogr2ogrJob::appendLog(const QByteArray &text) {
+    // one block per job, concurrent jobs do not interleave
+    const QString logPath = QDir::toNativeSeparators(QCoreApplication::applicationDirPath() + QDir::separator() + "ogr2ogr.log");
+    QMutexLocker locker(&logMutex);
+    QFile log(logPath);
+    if(log.open(QIODevice::Append | QIODevice::Text)) {
+        log.write(text);
+        log.close();
+    }
+}
+
+void Ogr2ogrJob::run(void) {
+    emit started();
+    if(engine.isCancelled()) {
+        emit translated(false, tr("cancelled by user"));
+        return;
+    }
+    percent = -1;
+    timer.start();
+    bool resVal;
+    QString error;
+    if(separateProcess) {
+        resVal = runProcess(error);
+    } else {
+        resVal = engine.translate(spec);
+        error = QString::fromStdString(engine.getError());
+        appendLog(command.toUtf8() + "\n" + (error.isEmpty() ? QByteArray() : error.toUtf8() + "\n"));
+    }
+    emit translated(resVal, error);
+}
@@ -0,0 +1,168 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file ogr2ogrProcess.cpp
+ *	\brief ogr2ogr Process
+ *	\author David Tran
+ *	\version 0.8
+ */
+
+#include "ogr2ogrProcess.h"
+#include "gdal.h"
+#include "cpl_vsi.h"
+#include "cpl_error.h"
+
+#include <QCoreApplication>
+#include <QStandardPaths>
+#include <QTimer>
+
+#ifdef Q_OS_UNIX
+#include <signal.h>
+#endif
+
+Ogr2ogrProcess::Ogr2ogrProcess(const ConversionSpec spec, QObject *parent) : QObject(parent), spec(spec), created(false), cancelled(false) {
+    process.setProcessChannelMode(QProcess::MergedChannels);
+    QObject::connect(&process, SIGNAL(readyReadStandardOutput()), this, SLOT(evtReadyRead(void)));
+    QObject::connect(&process, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(evtFinished(int, QProcess::ExitStatus)));
+    QObject::connect(&process, SIGNAL(error(QProcess::ProcessError)), this, SLOT(evtError(QProcess::ProcessError)));
+}
+
+Ogr2ogrProcess::~Ogr2ogrProcess(void) {
+}
+
+QString Ogr2ogrProcess::program(void) {
+    const QString ogr2ogr = QStandardPaths::findExecutable("ogr2ogr");
+    if(!ogr2ogr.isEmpty())
+        return ogr2ogr;
+    return QCoreApplication::applicationFilePath();
+}
+
+QStringList Ogr2ogrProcess::arguments(void) const {
+    QStringList list = spec.arguments();
+    // the ogr2ogr of GDAL 2.1 on PATH has no -if, the child probes all
+    // drivers then, the command line mode of the application takes it
+    const int inputFormatIndex = list.indexOf("-if");
+    if(inputFormatIndex >= 0 && inputFormatIndex + 1 < list.size() && program() != QCoreApplication::applicationFilePath())
+        list.erase(list.begin() + inputFormatIndex, list.begin() + inputFormatIndex + 2);
+    if(!list.contains("-progress"))
+        list << "-progress";
+    return list;
+}
+
+void Ogr2ogrProcess::start(void) {
+    VSIStatBufL sStat;
+    created = VSIStatL(spec.target.toUtf8().constData(), &sStat) != 0;
+    cancelled = false;
+    transcript.clear();
+    process.start(program(), arguments(), QIODevice::ReadOnly);
+}
+
+QByteArray Ogr2ogrProcess::getTranscript(void) const {
+    return transcript;
+}
+
+bool Ogr2ogrProcess::isRunning(void) const {
+    return process.state() != QProcess::NotRunning;
+}
+
+void Ogr2ogrProcess::cancel(void) {
+    if(!isRunning())
+        return;
+    pause(false);
+    error = tr("cancelled by user");
+    cancelled = true;
+    // the server rolls back the open transaction when the connection drops
+    process.terminate();
+    QTimer::singleShot(3000, &process, SLOT(kill()));
+}
+
+bool Ogr2ogrProcess::pause(const bool enable) {
+#ifdef Q_OS_UNIX
+    if(isRunning())
+        return ::kill(process.processId(), enable ? SIGSTOP : SIGCONT) == 0;
+#else
+    Q_UNUSED(enable);
+#endif
+    return false;
+}
+
+void Ogr2ogrProcess::evtReadyRead(void) {
+    const QByteArray data = process.readAllStandardOutput();
+    transcript += data;
+    output += data;
+    int eol;
+    while((eol = output.indexOf('\n')) >= 0) {
+        const QByteArray line = output.left(eol);
+        output.remove(0, eol + 1);
+        if(line.startsWith("ERROR") || line.startsWith("FAILURE")) {
+            if(!error.isEmpty())
+                error += "\n";
+            error += QString::fromLocal8Bit(line).trimmed();
+        }
+    }
+    // GDALTermProgress prints "0...10...20..." without line breaks
+    int end = output.size();
+    while(end > 0 && output.at(end - 1) == '.')
+        --end;
+    int start = end;
+    while(start > 0 && output.at(start - 1) >= '0' && output.at(start - 1) <= '9')
+        --start;
+    if(start < end && end < output.size()) {
+        bool ok;
+        const int percent = output.mid(start, end - start).toInt(&ok);
+        if(ok)
+            emit progressChanged(percent, -1, -1);
+    }
+}
+
+void Ogr2ogrProcess::evtFinished(int exitCode, QProcess::ExitStatus exitStatus) {
+    evtReadyRead();
+    const bool resVal = exitStatus == QProcess::NormalExit && exitCode == 0 && !cancelled;
+    if(cancelled)
+        removeTarget();
+    if(!resVal && error.isEmpty())
+        error = tr("ogr2ogr exited with code ") + QString::number(exitCode);
+    emit translated(resVal, error);
+}
+
+void Ogr2ogrProcess::removeTarget(void) {
+    // as Ogr2ogrEngine does, only a target this job created is removed
+    VSIStatBufL sStat;
+    const QByteArray target = spec.target.toUtf8();
+    if(!created || VSIStatL(target.constData(), &sStat) != 0)
+        return;
+    GDALDriverH hDriver = GDALGetDriverByName(spec.targetFormat.toUtf8().constData());
+    if(hDriver == NULL)
+        return;
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    GDALDeleteDataset(hDriver, target.constData());
+    CPLPopErrorHandler();
+}
+
+void Ogr2ogrProcess::evtError(QProcess::ProcessError processError) {
+    if(processError != QProcess::FailedToStart)
+        return;
+    emit translated(false, tr("unable to start ") + program());
+}
@@ -0,0 +1,123 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file preflight.cpp
+ *	\brief Preflight
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "preflight.h"
+
+#include <QtConcurrent>
+#include <QCryptographicHash>
+#include <QDateTime>
+
+// connection strings have nothing to stat, their reports expire instead
+static const qint64 CONNECTION_LIFETIME = 5 * 60;
+
+QMutex Preflight::cacheMutex;
+QHash<QString, Preflight::CacheEntry> Preflight::cache;
+
+QString Preflight::cacheKey(const PreflightRequest &request, bool &connection) {
+    qlonglong mtime, size;
+    const QString source = SourceCatalog::fingerprint(request.source, mtime, size);
+    connection = size < 0;
+    const QStringList fields = QStringList() << source << QString::number(mtime) << QString::number(size)
+            << request.sourceFormat << request.layers.join(",") << request.query << request.targetFormat
+            << QString::number(request.targetProjection) << QString::number(request.testFeatures) << QString::number(request.samples) << QString::number(request.countFeatures);
+    return QCryptographicHash::hash(fields.join("\n").toUtf8(), QCryptographicHash::Sha1).toHex();
+}
+
+bool Preflight::checkDriver(const QString format) {
+    Ogr ogr;
+    return ogr.openDriver(format.toStdString());
+}
+
+bool Preflight::checkProjection(const int projection) {
+    Ogr ogr;
+    return ogr.testSpatialReference(projection);
+}
+
+PreflightReport Preflight::run(Ogr *ogr, const PreflightRequest request) {
+    PreflightReport report;
+    bool connection;
+    const QString key = cacheKey(request, connection);
+    const qint64 now = QDateTime::currentDateTime().toTime_t();
+    cacheMutex.lock();
+    const bool cached = cache.contains(key) && (!cache.value(key).connection || cache.value(key).stored + CONNECTION_LIFETIME > now);
+    if(cached)
+        report = cache.value(key).report;
+    cacheMutex.unlock();
+    // separate Ogr instances, the source checks below own the caller's one
+    QFuture<bool> driver;
+    QFuture<bool> projection;
+    if(!cached) {
+        driver = QtConcurrent::run(checkDriver, request.targetFormat);
+        projection = QtConcurrent::run(checkProjection, request.targetProjection);
+    }
+
+    string epsg, query, error;
+    ogr->setSourceFormat(request.sourceFormat.toStdString());
+    if(request.layers.isEmpty()) {
+        report.sourceOpened = ogr->openSource(request.source.toStdString(), epsg, query, error);
+    } else {
+        report.sourceOpened = true;
+        foreach(QString layer, request.layers) {
+            if(!ogr->openSource(request.source.toStdString(), layer.toStdString(), epsg, query, error)) {
+                report.sourceOpened = false;
+                break;
+            }
+        }
+    }
+    // the caller reads the open source afterwards, only the tests are skipped
+    if(cached)
+        return report;
+    if(report.sourceOpened && !request.query.isEmpty())
+        report.queryValid = ogr->testExecuteSQL(request.query.toStdString());
+
+    report.driverFound = driver.result();
+    report.projectionValid = projection.result();
+    if(report.sourceOpened && report.queryValid && report.driverFound && report.projectionValid && request.testFeatures) {
+        // cheap now, the EPSG tables were read by the projection task
+        ogr->testSpatialReference(request.targetProjection);
+        report.featuresTransformed = ogr->testFeatureProjection(request.samples);
+    }
+    // a full scan for sources without a fast count, kept off the GUI thread
+    if(report.sourceOpened && request.countFeatures)
+        report.features = ogr->getSourceFeatureCount();
+    // a source which can not be opened may be a server that is down for now
+    if(report.sourceOpened) {
+        QMutexLocker locker(&cacheMutex);
+        if(cache.size() >= 64)
+            cache.clear();
+        CacheEntry entry;
+        entry.report = report;
+        entry.stored = now;
+        entry.connection = connection;
+        cache.insert(key, entry);
+    }
+    return report;
+}
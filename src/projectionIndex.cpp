@@ -0,0 +1,167 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file projectionIndex.cpp
+ *	\brief Projection Index
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "projectionIndex.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTextStream>
+#include <algorithm>
+#include <cstring>
+
+/*
+ * Index layout, little endian:
+ *   header   "O2GP", version, fingerprint[16], count, checksum of the rest
+ *   entries  count x (EPSG code, name offset, name length)
+ *   pool     UTF-8 names
+ */
+static const char INDEX_MAGIC[4] = { 'O', '2', 'G', 'P' };
+static const quint32 INDEX_VERSION = 1;
+static const int HEADER_SIZE = 4 + 4 + 16 + 4 + 4;
+static const int ENTRY_SIZE = 12;
+static const QString INDEX_FILE = "ogr2gui.idx";
+
+static quint32 readUInt32(const uchar *data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<quint32>(data[3]) << 24);
+}
+
+static void appendUInt32(QByteArray &data, const quint32 value) {
+    data.append(static_cast<char>(value & 0xFF));
+    data.append(static_cast<char>((value >> 8) & 0xFF));
+    data.append(static_cast<char>((value >> 16) & 0xFF));
+    data.append(static_cast<char>((value >> 24) & 0xFF));
+}
+
+bool ProjectionIndex::load(const QStringList files, QList<QPair<QString, QString> > &projections) {
+    const QByteArray hash = fingerprint(files);
+    if(read(hash, projections))
+        return true;
+    QList<QPair<int, QString> > parsed;
+    for(int i = 0; i < files.size(); ++i)
+        parse(files.at(i), parsed);
+    std::stable_sort(parsed.begin(), parsed.end(), [](const QPair<int, QString> &a, const QPair<int, QString> &b) { return a.first < b.first; });
+    for(int i = 0; i < parsed.size(); ++i)
+        projections << QPair<QString, QString>(QString::number(parsed.at(i).first), parsed.at(i).second);
+    write(hash, parsed);
+    return false;
+}
+
+QByteArray ProjectionIndex::fingerprint(const QStringList files) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for(int i = 0; i < files.size(); ++i) {
+        const QFileInfo info(files.at(i));
+        hash.addData(info.absoluteFilePath().toUtf8());
+        hash.addData(QByteArray::number(info.size()));
+        hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    }
+    return hash.result();
+}
+
+void ProjectionIndex::parse(const QString filename, QList<QPair<int, QString> > &projections) {
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+    QTextStream in(&file);
+    QString line;
+    while(!(line = in.readLine()).isNull()) {
+        QStringList t = line.split(",");
+        bool isInteger;
+        const int code = t.at(0).toInt(&isInteger);
+        if(!isInteger || t.size() < 2)
+            continue;
+        projections << QPair<int, QString>(code, t.at(1));
+    }
+    file.close();
+}
+
+bool ProjectionIndex::read(const QByteArray fingerprint, QList<QPair<QString, QString> > &projections) {
+    QFile file(INDEX_FILE);
+    if(!file.open(QIODevice::ReadOnly) || file.size() < HEADER_SIZE)
+        return false;
+    const qint64 size = file.size();
+    const uchar *data = file.map(0, size);
+    if(data == NULL)
+        return false;
+    bool valid = memcmp(data, INDEX_MAGIC, 4) == 0 && readUInt32(data + 4) == INDEX_VERSION
+            && memcmp(data + 8, fingerprint.constData(), 16) == 0;
+    const quint32 count = readUInt32(data + 24);
+    valid = valid && HEADER_SIZE + static_cast<qint64>(count) * ENTRY_SIZE <= size
+            && readUInt32(data + 28) == qChecksum(reinterpret_cast<const char*>(data + HEADER_SIZE), static_cast<uint>(size - HEADER_SIZE));
+    if(valid) {
+        const uchar *entries = data + HEADER_SIZE;
+        const char *pool = reinterpret_cast<const char*>(entries + count * ENTRY_SIZE);
+        const qint64 poolSize = size - HEADER_SIZE - count * ENTRY_SIZE;
+        QList<QPair<QString, QString> > indexed;
+        indexed.reserve(count);
+        for(quint32 i = 0; i < count && valid; ++i) {
+            const uchar *entry = entries + i * ENTRY_SIZE;
+            const quint32 offset = readUInt32(entry + 4);
+            const quint32 length = readUInt32(entry + 8);
+            valid = static_cast<qint64>(offset) + length <= poolSize;
+            if(valid)
+                indexed << QPair<QString, QString>(QString::number(readUInt32(entry)), QString::fromUtf8(pool + offset, length));
+        }
+        if(valid)
+            projections << indexed;
+    }
+    file.unmap(const_cast<uchar*>(data));
+    file.close();
+    return valid;
+}
+
+void ProjectionIndex::write(const QByteArray fingerprint, const QList<QPair<int, QString> > &projections) {
+    QByteArray entries;
+    QByteArray pool;
+    entries.reserve(projections.size() * ENTRY_SIZE);
+    for(int i = 0; i < projections.size(); ++i) {
+        const QByteArray name = projections.at(i).second.toUtf8();
+        appendUInt32(entries, static_cast<quint32>(projections.at(i).first));
+        appendUInt32(entries, pool.size());
+        appendUInt32(entries, name.size());
+        pool.append(name);
+    }
+    const QByteArray body = entries + pool;
+    QByteArray header(INDEX_MAGIC, 4);
+    appendUInt32(header, INDEX_VERSION);
+    header.append(fingerprint);
+    appendUInt32(header, projections.size());
+    appendUInt32(header, qChecksum(body.constData(), body.size()));
+    // written aside and renamed, a concurrent launch never maps half a file
+    QSaveFile file(INDEX_FILE);
+    if(!file.open(QIODevice::WriteOnly))
+        return;
+    file.write(header);
+    file.write(body);
+    file.commit();
+}
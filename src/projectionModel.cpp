@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file projectionModel.cpp
+ *	\brief Projection Model
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "projectionModel.h"
+
+ProjectionModel::ProjectionModel(QList<QPair<QString, QString> > *projections, QObject *parent) :
+    QAbstractListModel(parent), projections(projections) {
+}
+
+int ProjectionModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : projections->size();
+}
+
+QVariant ProjectionModel::data(const QModelIndex &index, int role) const {
+    if(!index.isValid() || index.row() >= projections->size())
+        return QVariant();
+    if(role != Qt::DisplayRole && role != Qt::EditRole)
+        return QVariant();
+    const QPair<QString, QString> &pair = projections->at(index.row());
+    // the empty first row stands for "no projection"
+    if(pair.first.isEmpty())
+        return QString();
+    return pair.first + " " + pair.second;
+}
+
+void ProjectionModel::setProjections(const QList<QPair<QString, QString> > &list) {
+    // the views must not read the list while it changes
+    beginResetModel();
+    *projections = list;
+    projections->insert(0, QPair<QString, QString>());
+    search.build(*projections);
+    endResetModel();
+}
+
+int ProjectionModel::indexOf(const QString code) const {
+    return search.find(code);
+}
+
+const ProjectionSearch &ProjectionModel::getSearch(void) const {
+    return search;
+}
@@ -0,0 +1,176 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file projectionSearch.cpp
+ *	\brief Projection Search
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "projectionSearch.h"
+
+#include <QSet>
+#include <algorithm>
+
+ProjectionSearch::ProjectionSearch(void) {
+    trie.append(Node());
+}
+
+quint64 ProjectionSearch::trigram(const QString &text, const int position) {
+    return (static_cast<quint64>(text.at(position).unicode()) << 32)
+            | (static_cast<quint64>(text.at(position + 1).unicode()) << 16)
+            | text.at(position + 2).unicode();
+}
+
+void ProjectionSearch::build(const QList<QPair<QString, QString> > &projections) {
+    codes.clear();
+    trie.clear();
+    trie.append(Node());
+    trigrams.clear();
+    names.clear();
+    names.reserve(projections.size());
+    for(int row = 0; row < projections.size(); ++row) {
+        const QString code = projections.at(row).first;
+        const QString name = projections.at(row).second.toLower();
+        names.append(name);
+        if(code.isEmpty())
+            continue;
+        if(!codes.contains(code))
+            codes.insert(code, row);
+        int current = 0;
+        for(int i = 0; i < code.size(); ++i) {
+            const int digit = code.at(i).digitValue();
+            if(digit < 0)
+                break;
+            if(trie[current].children[digit] < 0) {
+                trie[current].children[digit] = trie.size();
+                trie.append(Node());
+            }
+            current = trie[current].children[digit];
+        }
+        if(trie[current].first < 0)
+            trie[current].first = row;
+        QSet<quint64> seen;
+        for(int i = 0; i + 2 < name.size(); ++i) {
+            const quint64 key = trigram(name, i);
+            if(!seen.contains(key)) {
+                seen.insert(key);
+                trigrams[key].append(row);
+            }
+        }
+    }
+}
+
+int ProjectionSearch::find(const QString code) const {
+    return codes.value(code, -1);
+}
+
+int ProjectionSearch::node(const QString prefix) const {
+    int current = 0;
+    for(int i = 0; i < prefix.size() && current >= 0; ++i) {
+        const int digit = prefix.at(i).digitValue();
+        if(digit < 0)
+            return -1;
+        current = trie.at(current).children[digit];
+    }
+    return current;
+}
+
+int ProjectionSearch::findPrefix(const QString prefix) const {
+    QList<int> rows;
+    const int current = node(prefix);
+    if(current >= 0)
+        collect(current, 1, rows);
+    return rows.isEmpty() ? -1 : rows.first();
+}
+
+void ProjectionSearch::collect(const int start, const int limit, QList<int> &rows) const {
+    // breadth first: shorter codes are smaller and a level is visited in
+    // digit order, the rows thus come in numeric order of their codes
+    QList<int> level;
+    level.append(start);
+    while(!level.isEmpty()) {
+        QList<int> next;
+        foreach(int current, level) {
+            if(trie.at(current).first >= 0) {
+                rows.append(trie.at(current).first);
+                if(rows.size() >= limit)
+                    return;
+            }
+            for(int digit = 0; digit < 10; ++digit)
+                if(trie.at(current).children[digit] >= 0)
+                    next.append(trie.at(current).children[digit]);
+        }
+        level = next;
+    }
+}
+
+QList<int> ProjectionSearch::search(const QString text, const int limit) const {
+    QList<int> rows;
+    const QString needle = text.trimmed().toLower();
+    if(needle.isEmpty() || limit <= 0)
+        return rows;
+    bool isInteger;
+    needle.toInt(&isInteger);
+    if(isInteger) {
+        const int current = node(needle);
+        if(current >= 0)
+            collect(current, limit, rows);
+        return rows;
+    }
+    if(needle.size() < 3) {
+        for(int row = 0; row < names.size() && rows.size() < limit; ++row)
+            if(names.at(row).startsWith(needle))
+                rows.append(row);
+        return rows;
+    }
+    // rank by shared trigrams, then names starting with the text, then shorter names
+    QHash<int, int> hits;
+    for(int i = 0; i + 2 < needle.size(); ++i) {
+        QHash<quint64, QVector<int> >::const_iterator it = trigrams.find(trigram(needle, i));
+        if(it == trigrams.end())
+            continue;
+        foreach(int row, it.value())
+            ++hits[row];
+    }
+    QList<QPair<int, int> > ranked;
+    for(QHash<int, int>::const_iterator it = hits.begin(); it != hits.end(); ++it)
+        ranked.append(QPair<int, int>(it.key(), it.value()));
+    const QVector<QString> &names = this->names;
+    std::sort(ranked.begin(), ranked.end(), [&names, &needle](const QPair<int, int> &a, const QPair<int, int> &b) {
+        if(a.second != b.second)
+            return a.second > b.second;
+        const bool aPrefix = names.at(a.first).startsWith(needle);
+        const bool bPrefix = names.at(b.first).startsWith(needle);
+        if(aPrefix != bPrefix)
+            return aPrefix;
+        if(names.at(a.first).size() != names.at(b.first).size())
+            return names.at(a.first).size() < names.at(b.first).size();
+        return a.first < b.first;
+    });
+    for(int i = 0; i < ranked.size() && i < limit; ++i)
+        rows.append(ranked.at(i).first);
+    return rows;
+}
@@ -35,7 +35,9 @@ Settings::Settings(QWidget *parent) : QDialog(parent) {
     initInterface();
     initSlots();
     translateInterface();
+    StartupTimer::begin("initSettings");
     initSettings();
+    StartupTimer::end("initSettings");
 
     this->setWindowModality(Qt::ApplicationModal);
     this->setMinimumWidth(280);
@@ -74,10 +76,24 @@ void Settings::initSettings(void) {
     pcs = settings.value("pcs");
     gcsoverride = settings.value("gcsoverride");
     pcsoverride = settings.value("pcsoverride");
+    process = settings.value("process");
+    threads = settings.value("threads");
+    splitlayers = settings.value("splitlayers");
+    batch = settings.value("batch");
+    retries = settings.value("retries");
+    shards = settings.value("shards");
+    samples = settings.value("samples");
     ckbGcs->setChecked(gcs.toBool());
     ckbPcs->setChecked(pcs.toBool());
     ckbGcsOverride->setChecked(gcsoverride.toBool());
     ckbPcsOverride->setChecked(pcsoverride.toBool());
+    ckbProcess->setChecked(process.toBool());
+    spbThreads->setValue(threads.toInt());
+    ckbSplitLayers->setChecked(splitlayers.toBool());
+    ckbBatch->setChecked(batch.toBool());
+    spbRetries->setValue(retries.toInt());
+    spbShards->setValue(shards.toInt());
+    spbSamples->setValue(samples.toInt());
 }
 
 void Settings::initInterface(void) {
@@ -114,6 +130,42 @@ void Settings::initInterface(void) {
             lytFile->addWidget(ckbPcsOverride, 4, 1);
         }
 
+        lytConvert = new QGridLayout();
+        {
+            lblConvert = new QLabel();
+            lblConvert->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+            lblConvert->setMinimumSize(70, 20);
+            lblConvert->setMaximumSize(70, 20);
+            ckbProcess = new QCheckBox;
+            ckbSplitLayers = new QCheckBox;
+            ckbBatch = new QCheckBox;
+            lblRetries = new QLabel();
+            spbRetries = new QSpinBox();
+            spbRetries->setRange(0, 10);
+            lblShards = new QLabel();
+            spbShards = new QSpinBox();
+            spbShards->setRange(1, 64);
+            lblSamples = new QLabel();
+            spbSamples = new QSpinBox();
+            spbSamples->setRange(0, 1000000);
+            lblThreads = new QLabel();
+            spbThreads = new QSpinBox();
+            spbThreads->setRange(1, qMax(1, QThread::idealThreadCount()) * 2);
+
+            lytConvert->addWidget(lblConvert, 1, 0);
+            lytConvert->addWidget(ckbProcess, 1, 1);
+            lytConvert->addWidget(lblThreads, 2, 0);
+            lytConvert->addWidget(spbThreads, 2, 1);
+            lytConvert->addWidget(ckbSplitLayers, 3, 1);
+            lytConvert->addWidget(ckbBatch, 4, 1);
+            lytConvert->addWidget(lblRetries, 5, 0);
+            lytConvert->addWidget(spbRetries, 5, 1);
+            lytConvert->addWidget(lblShards, 6, 0);
+            lytConvert->addWidget(spbShards, 6, 1);
+            lytConvert->addWidget(lblSamples, 7, 0);
+            lytConvert->addWidget(spbSamples, 7, 1);
+        }
+
         lytDialog = new QHBoxLayout();
         {
             btnOK = new QPushButton();
@@ -125,6 +177,7 @@ void Settings::initInterface(void) {
 
         theLayout->addLayout(lytLang);
         theLayout->addLayout(lytFile);
+        theLayout->addLayout(lytConvert);
         theLayout->addLayout(lytDialog);
     }
 
@@ -145,6 +198,16 @@ void Settings::translateInterface(void) {
     ckbPcs->setText("pcs.csv");
     ckbGcsOverride->setText("gcs.override.csv");
     ckbPcsOverride->setText("pcs.override.csv");
+    lblConvert->setText(tr("Convert"));
+    ckbProcess->setText(tr("separate process"));
+    lblThreads->setText(tr("Parallel jobs"));
+    ckbSplitLayers->setText(tr("one job per layer"));
+    ckbBatch->setText(tr("one job per file in folders"));
+    lblRetries->setText(tr("Retries"));
+    lblShards->setText(tr("Shards"));
+    lblSamples->setText(tr("Check"));
+    spbSamples->setSpecialValueText(tr("all features"));
+    spbSamples->setSuffix(tr(" features"));
     btnOK->setText(tr("Save"));
     btnCancel->setText(tr("Cancel"));
 }
@@ -159,6 +222,13 @@ void Settings::evtBtnOK(void) {
     settings.setValue("pcs", ckbPcs->isChecked());
     settings.setValue("gcsoverride", ckbGcsOverride->isChecked());
     settings.setValue("pcsoverride", ckbPcsOverride->isChecked());
+    settings.setValue("process", ckbProcess->isChecked());
+    settings.setValue("threads", spbThreads->value());
+    settings.setValue("splitlayers", ckbSplitLayers->isChecked());
+    settings.setValue("batch", ckbBatch->isChecked());
+    settings.setValue("retries", spbRetries->value());
+    settings.setValue("shards", spbShards->value());
+    settings.setValue("samples", spbSamples->value());
     this->accept();
 }
 
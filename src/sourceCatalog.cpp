@@ -0,0 +1,173 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file sourceCatalog.cpp
+ *	\brief Source Catalog
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "sourceCatalog.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFileInfo>
+
+// connection strings have nothing to stat, their entries expire instead
+static const qint64 CONNECTION_LIFETIME = 5 * 60;
+
+QAtomicInt SourceCatalog::connections;
+
+SourceCatalog::Connection::Connection(void) {
+    // QSqlDatabase connections can only be used by the thread creating them
+    name = "catalog" + QString::number(connections.fetchAndAddOrdered(1));
+    QSqlDatabase base = QSqlDatabase::addDatabase("QSQLITE", name);
+    base.setDatabaseName("ogr2gui.sqlite");
+    base.setConnectOptions("QSQLITE_BUSY_TIMEOUT=2000");
+    if(base.open()) {
+        QSqlQuery query(base);
+        query.exec("CREATE TABLE IF NOT EXISTS sources (key TEXT PRIMARY KEY, mtime INTEGER, size INTEGER, stored INTEGER)");
+        query.exec("CREATE TABLE IF NOT EXISTS layers (key TEXT, position INTEGER, name TEXT, geometry TEXT, epsg TEXT, fields TEXT, "
+                   "minx REAL, miny REAL, maxx REAL, maxy REAL, features INTEGER)");
+        query.exec("CREATE INDEX IF NOT EXISTS layers_key ON layers (key)");
+        // catalogs of earlier versions, fails once the column exists
+        query.exec("ALTER TABLE sources ADD COLUMN files TEXT");
+    }
+}
+
+SourceCatalog::Connection::~Connection(void) {
+    // declared first in the calls, their handles and queries are gone by now
+    QSqlDatabase::database(name, false).close();
+    QSqlDatabase::removeDatabase(name);
+}
+
+QSqlDatabase SourceCatalog::Connection::database(void) const {
+    return QSqlDatabase::database(name, false);
+}
+
+QString SourceCatalog::fingerprint(const QString source, qlonglong &mtime, qlonglong &size) {
+    const QFileInfo info(source);
+    QString key = source;
+    mtime = 0;
+    size = -1;
+    if(info.exists()) {
+        key = info.canonicalFilePath();
+        mtime = info.lastModified().toMSecsSinceEpoch();
+        size = info.size();
+    }
+    return QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+}
+
+void SourceCatalog::state(const QStringList files, qlonglong &mtime, qlonglong &size) {
+    mtime = 0;
+    size = 0;
+    foreach(const QString file, files) {
+        const QFileInfo info(file);
+        if(!info.exists())
+            continue;
+        mtime = qMax(mtime, info.lastModified().toMSecsSinceEpoch());
+        size += info.size();
+    }
+}
+
+bool SourceCatalog::lookup(const QString source, QList<LayerInfo> &layers) {
+    qlonglong mtime, size;
+    const QString key = fingerprint(source, mtime, size);
+    const Connection connection;
+    QSqlDatabase base = connection.database();
+    if(!base.isOpen())
+        return false;
+    QSqlQuery query(base);
+    query.prepare("SELECT mtime, size, stored, files FROM sources WHERE key = ?");
+    query.addBindValue(key);
+    if(!query.exec() || !query.next())
+        return false;
+    if(size >= 0)
+        state(QStringList() << source << query.value(3).toString().split('\n', QString::SkipEmptyParts), mtime, size);
+    if(query.value(0).toLongLong() != mtime || query.value(1).toLongLong() != size)
+        return false;
+    if(size < 0 && query.value(2).toLongLong() + CONNECTION_LIFETIME < QDateTime::currentDateTime().toTime_t())
+        return false;
+    query.prepare("SELECT name, geometry, epsg, fields, minx, miny, maxx, maxy, features FROM layers WHERE key = ? ORDER BY position");
+    query.addBindValue(key);
+    if(!query.exec())
+        return false;
+    layers.clear();
+    while(query.next()) {
+        LayerInfo layer;
+        layer.name = query.value(0).toString();
+        layer.geometry = query.value(1).toString();
+        layer.epsg = query.value(2).toString();
+        layer.fields = query.value(3).toString();
+        layer.minX = query.value(4).toDouble();
+        layer.minY = query.value(5).toDouble();
+        layer.maxX = query.value(6).toDouble();
+        layer.maxY = query.value(7).toDouble();
+        layer.features = query.value(8).toLongLong();
+        layers.append(layer);
+    }
+    return !layers.isEmpty();
+}
+
+void SourceCatalog::store(const QString source, const QList<LayerInfo> &layers, const QStringList files) {
+    qlonglong mtime, size;
+    const QString key = fingerprint(source, mtime, size);
+    // sidecars as .dbf and .prj change without the main file
+    if(size >= 0)
+        state(QStringList() << source << files, mtime, size);
+    const Connection connection;
+    QSqlDatabase base = connection.database();
+    if(!base.isOpen())
+        return;
+    base.transaction();
+    QSqlQuery query(base);
+    query.prepare("DELETE FROM layers WHERE key = ?");
+    query.addBindValue(key);
+    query.exec();
+    query.prepare("INSERT OR REPLACE INTO sources (key, mtime, size, stored, files) VALUES (?, ?, ?, ?, ?)");
+    query.addBindValue(key);
+    query.addBindValue(mtime);
+    query.addBindValue(size);
+    query.addBindValue(static_cast<qlonglong>(QDateTime::currentDateTime().toTime_t()));
+    query.addBindValue(files.join("\n"));
+    query.exec();
+    query.prepare("INSERT INTO layers (key, position, name, geometry, epsg, fields, minx, miny, maxx, maxy, features) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    for(int i = 0; i < layers.size(); ++i) {
+        query.addBindValue(key);
+        query.addBindValue(i);
+        query.addBindValue(layers.at(i).name);
+        query.addBindValue(layers.at(i).geometry);
+        query.addBindValue(layers.at(i).epsg);
+        query.addBindValue(layers.at(i).fields);
+        query.addBindValue(layers.at(i).minX);
+        query.addBindValue(layers.at(i).minY);
+        query.addBindValue(layers.at(i).maxX);
+        query.addBindValue(layers.at(i).maxY);
+        query.addBindValue(layers.at(i).features);
+        query.exec();
+    }
+    base.commit();
+}
@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file sourceProbe.cpp
+ *	\brief Source Probe
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "sourceProbe.h"
+#include "ogr.h"
+#include "sourceCatalog.h"
+
+SourceProbe::SourceProbe(QObject *parent) : QObject(parent), generation(0) {
+    pool.setMaxThreadCount(4);
+    timer.setSingleShot(true);
+    timer.setInterval(400);
+    connect(&timer, SIGNAL(timeout()), this, SLOT(evtTimeout()));
+}
+
+SourceProbe::~SourceProbe(void) {
+    pool.clear();
+    pool.waitForDone();
+}
+
+void SourceProbe::probe(const QString name, const QString format) {
+    this->name = name;
+    this->format = format;
+    ++generation;
+    timer.start();
+}
+
+void SourceProbe::evtTimeout(void) {
+    // probes waiting for a thread are stale now
+    pool.clear();
+    pool.start(new SourceProbeTask(this, generation, name, format));
+}
+
+void SourceProbe::evtProbed(int generation, bool success, QString layer, QString epsg, QString query) {
+    if(generation == this->generation)
+        emit probed(success, layer, epsg, query);
+}
+
+SourceProbeTask::SourceProbeTask(SourceProbe *probe, const int generation, const QString name, const QString format) :
+    probe(probe), generation(generation), name(name), format(format) {
+}
+
+void SourceProbeTask::run(void) {
+    QList<LayerInfo> layers;
+    bool success = SourceCatalog::lookup(name, layers);
+    if(!success) {
+        Ogr ogr;
+        ogr.setSourceFormat(format.toStdString());
+        string epsg, query, error;
+        success = ogr.openSource(name.toStdString(), epsg, query, error);
+        if(success) {
+            layers = ogr.getSourceLayers();
+            const QStringList files = ogr.getSourceFiles();
+            ogr.closeSource();
+            SourceCatalog::store(name, layers, files);
+        }
+    }
+    QString layer, epsg, query;
+    if(success && !layers.isEmpty()) {
+        // same defaults as Ogr::openSource for the first layer
+        layer = layers.first().name;
+        epsg = layers.first().epsg;
+        if(epsg.isEmpty())
+            query = "SELECT * FROM " + layer;
+    }
+    QMetaObject::invokeMethod(probe, "evtProbed", Qt::QueuedConnection,
+                              Q_ARG(int, generation), Q_ARG(bool, success), Q_ARG(QString, layer),
+                              Q_ARG(QString, epsg), Q_ARG(QString, query));
+}
@@ -0,0 +1,160 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file srsCache.cpp
+ *	\brief Spatial Reference Cache
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "srsCache.h"
+#include "cpl_conv.h"
+
+#include <QString>
+
+QMutex SrsCache::instanceMutex;
+SrsCache* SrsCache::instance;
+
+SrsCache::SrsCache(void) : capacity(16) {
+}
+
+SrsCache::~SrsCache(void) {
+    clear();
+    foreach(const Reference &reference, references) {
+        if(reference.hSRS != NULL)
+            OSRRelease(reference.hSRS);
+    }
+}
+
+SrsCache* SrsCache::getInstance(void) {
+    QMutexLocker locker(&instanceMutex);
+    if(instance == NULL)
+        instance = new SrsCache();
+    return instance;
+}
+
+SrsCache::Reference SrsCache::import(const int epsg) {
+    QMutexLocker locker(&mutex);
+    QHash<int, Reference>::const_iterator it = references.constFind(epsg);
+    if(it != references.constEnd())
+        return it.value();
+    // the lookup in the data/*.csv tables is what makes this worth caching,
+    // importing under the lock keeps it to once per code
+    Reference reference;
+    reference.hSRS = OSRNewSpatialReference(NULL);
+    reference.eErr = OSRImportFromEPSG(reference.hSRS, epsg);
+    if(reference.eErr == OGRERR_NONE) {
+        char *pszWKT = NULL;
+        if(OSRExportToWkt(reference.hSRS, &pszWKT) == OGRERR_NONE)
+            reference.wkt = pszWKT;
+        CPLFree(pszWKT);
+    } else {
+        OSRRelease(reference.hSRS);
+        reference.hSRS = NULL;
+    }
+    references.insert(epsg, reference);
+    return reference;
+}
+
+OGRSpatialReferenceH SrsCache::get(const int epsg, OGRErr *eErr) {
+    const Reference reference = import(epsg);
+    if(eErr != NULL)
+        *eErr = reference.eErr;
+    return reference.hSRS;
+}
+
+string SrsCache::wkt(const int epsg) {
+    return import(epsg).wkt;
+}
+
+OGRCoordinateTransformationH SrsCache::acquire(OGRSpatialReferenceH source, const int target) {
+    OGRSpatialReferenceH hTarget = get(target);
+    if(source == NULL || hTarget == NULL)
+        return NULL;
+    // layer references are not shared, they are keyed by their definition
+    char *pszWKT = NULL;
+    if(OSRExportToWkt(source, &pszWKT) != OGRERR_NONE) {
+        CPLFree(pszWKT);
+        return NULL;
+    }
+    const string key = string(pszWKT) + "|" + QString::number(target).toStdString();
+    CPLFree(pszWKT);
+
+    mutex.lock();
+    for(int i = 0; i < transformations.size(); ++i) {
+        if(transformations.at(i).inUse || transformations.at(i).key != key)
+            continue;
+        Transformation transformation = transformations.takeAt(i);
+        transformation.inUse = true;
+        transformations.prepend(transformation);
+        mutex.unlock();
+        return transformation.hCT;
+    }
+    mutex.unlock();
+
+    // the new transformation clones both references, the shared target is only read
+    OGRCoordinateTransformationH hCT = OCTNewCoordinateTransformation(source, hTarget);
+    if(hCT == NULL)
+        return NULL;
+    Transformation transformation;
+    transformation.key = key;
+    transformation.hCT = hCT;
+    transformation.inUse = true;
+    QMutexLocker locker(&mutex);
+    transformations.prepend(transformation);
+    evict();
+    return hCT;
+}
+
+void SrsCache::release(OGRCoordinateTransformationH hCT) {
+    if(hCT == NULL)
+        return;
+    QMutexLocker locker(&mutex);
+    for(int i = 0; i < transformations.size(); ++i) {
+        if(transformations.at(i).hCT != hCT)
+            continue;
+        transformations[i].inUse = false;
+        evict();
+        return;
+    }
+}
+
+void SrsCache::clear(void) {
+    QMutexLocker locker(&mutex);
+    for(int i = transformations.size() - 1; i >= 0; --i) {
+        if(!transformations.at(i).inUse)
+            OCTDestroyCoordinateTransformation(transformations.takeAt(i).hCT);
+    }
+}
+
+void SrsCache::evict(void) {
+    int idle = 0;
+    for(int i = 0; i < transformations.size(); ++i) {
+        if(transformations.at(i).inUse)
+            continue;
+        if(++idle > capacity)
+            OCTDestroyCoordinateTransformation(transformations.takeAt(i--).hCT);
+    }
+}
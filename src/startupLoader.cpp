@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file startupLoader.cpp
+ *	\brief Startup Loader
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "startupLoader.h"
+#include "projectionIndex.h"
+#include "ogr_api.h"
+#include "startupTimer.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QTextStream>
+
+StartupLoader::StartupLoader(QObject *parent) : QObject(parent) {
+    qRegisterMetaType<StartupData>("StartupData");
+    pool.setMaxThreadCount(1);
+}
+
+StartupLoader::~StartupLoader(void) {
+    pool.waitForDone();
+}
+
+void StartupLoader::load(const QStringList projectionFiles) {
+    pool.start(new StartupTask(this, projectionFiles));
+}
+
+void StartupLoader::readResources(QFile &file, QList<QPair<QString, QString> > &readonlyList, QList<QPair<QString, QString> > &readwriteList) {
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+    QTextStream in(&file);
+    QString line;
+    QPair<QString, QString> pair;
+    bool readwrite = true;
+    while(!(line = in.readLine()).isNull()) {
+        QStringList t = line.split(",");
+        if(line.compare("#readonly") == 0)
+            readwrite = false;
+        if(t.size() <= 1)
+            continue;
+        if(!t.at(0).isNull())
+            pair.first = t.at(0);
+        if(!t.at(1).isNull())
+            pair.second = t.at(1);
+        readonlyList << pair;
+        if(readwrite)
+            readwriteList << pair;
+    }
+    file.close();
+    qSort(readwriteList.begin(), readwriteList.end());
+    qSort(readonlyList.begin(), readonlyList.end());
+}
+
+QStringList StartupLoader::readProjections(const QStringList fileList, QList<QPair<QString, QString> > &projections) {
+    const QString folder = "data";
+    QStringList files;
+    QStringList missing;
+    foreach(QString filename, fileList) {
+        const QString filepath = QDir::toNativeSeparators(QCoreApplication::applicationDirPath() + QDir::separator() + folder + QDir::separator() + filename);
+        if(!QFile::exists(filepath)) {
+            missing << filename;
+            continue;
+        }
+        files << filepath;
+    }
+    // sorted by EPSG code, parsed only when the files changed
+    ProjectionIndex::load(files, projections);
+    return missing;
+}
+
+StartupTask::StartupTask(StartupLoader *loader, const QStringList projectionFiles) :
+    loader(loader), projectionFiles(projectionFiles) {
+}
+
+void StartupTask::run(void) {
+    StartupData data;
+    StartupTimer::begin("OGRRegisterAll");
+    OGRRegisterAll();
+    StartupTimer::end("OGRRegisterAll");
+    StartupTimer::begin("readResources");
+    QFile resFormats(":/formats");
+    QFile resDatabases(":/databases");
+    QFile resWebServices(":/webservices");
+    QList<QPair<QString, QString> > unused;
+    StartupLoader::readResources(resFormats, data.formatsReadOnly, data.formatsReadWrite);
+    StartupLoader::readResources(resDatabases, data.databasesReadOnly, data.databasesReadWrite);
+    StartupLoader::readResources(resWebServices, data.webServices, unused);
+    StartupTimer::end("readResources");
+    StartupTimer::begin("readProjections");
+    data.missingProjectionFiles = StartupLoader::readProjections(projectionFiles, data.projections);
+    StartupTimer::end("readProjections");
+    QMetaObject::invokeMethod(loader, "loaded", Qt::QueuedConnection, Q_ARG(StartupData, data));
+}
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file startupTimer.cpp
+ *	\brief Startup Timer
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "startupTimer.h"
+
+#include <iostream>
+
+QMutex StartupTimer::mutex;
+QElapsedTimer StartupTimer::clock;
+QList<StartupTimer::Phase> StartupTimer::phases;
+QAtomicInt StartupTimer::enabled;
+bool StartupTimer::exitWhenReady = false;
+
+void StartupTimer::start(void) {
+    const QByteArray mode = qgetenv("OGR2GUI_STARTUP_TIMING");
+    exitWhenReady = mode == "exit";
+    clock.start();
+    enabled.storeRelease(!mode.isEmpty() && mode != "0");
+}
+
+void StartupTimer::begin(const QString phase) {
+    if(!enabled.loadAcquire())
+        return;
+    QMutexLocker locker(&mutex);
+    Phase entry;
+    entry.name = phase;
+    entry.offset = clock.nsecsElapsed();
+    entry.duration = -1;
+    phases.append(entry);
+}
+
+void StartupTimer::end(const QString phase) {
+    if(!enabled.loadAcquire())
+        return;
+    QMutexLocker locker(&mutex);
+    const qint64 now = clock.nsecsElapsed();
+    for(int i = phases.size() - 1; i >= 0; --i) {
+        if(phases.at(i).name == phase && phases.at(i).duration < 0) {
+            phases[i].duration = now - phases.at(i).offset;
+            break;
+        }
+    }
+}
+
+bool StartupTimer::ready(void) {
+    // phases after the window is ready are not part of the startup
+    if(!enabled.fetchAndStoreOrdered(0))
+        return false;
+    QMutexLocker locker(&mutex);
+    const qint64 now = clock.nsecsElapsed();
+    foreach(const Phase &phase, phases) {
+        if(phase.duration < 0)
+            continue;
+        std::cerr << "startup " << phase.name.toStdString() << " "
+                  << phase.offset / 1000000.0 << " " << phase.duration / 1000000.0 << std::endl;
+    }
+    std::cerr << "startup ready 0 " << now / 1000000.0 << std::endl;
+    return exitWhenReady;
+}
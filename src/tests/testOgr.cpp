@@ -32,6 +32,7 @@
 #include "testOgr.h"
 
 TestOgr::TestOgr() {
+    OGRRegisterAll();
     ogr = new Ogr();
     path = QDir::toNativeSeparators(QCoreApplication::applicationDirPath() + QDir::separator() + "test" + QDir::separator()).toStdString();
     filename = "poly.shp";
@@ -242,4 +243,309 @@ void TestOgr::testSQLQuery() {
     QCOMPARE(resVal, true);
     resVal = ogr->testExecuteSQL("SELECT prfedea FROM " + sourceLayerName);
     QCOMPARE(resVal, true);
+    resVal = ogr->testExecuteSQL("SELECT * FROM " + sourceLayerName + " ORDER BY area DESC;");
+    QCOMPARE(resVal, true);
+    resVal = ogr->testExecuteSQL("SELECT * FROM unknown");
+    QCOMPARE(resVal, false);
+}
+
+void TestOgr::testFeatureProjection() {
+    string sourcename = path + filename;
+    string epsg;
+    string query;
+    string error;
+    bool resVal = ogr->openSource(sourcename, epsg, query, error);
+    QCOMPARE(resVal, true);
+    resVal = ogr->testSpatialReference(4326);
+    QCOMPARE(resVal, true);
+    resVal = ogr->testFeatureProjection(3);
+    QCOMPARE(resVal, true);
+    resVal = ogr->testFeatureProjection(0);
+    QCOMPARE(resVal, true);
+    ogr->closeSource();
+}
+
+void TestOgr::testSrsCache() {
+    SrsCache *cache = SrsCache::getInstance();
+    OGRSpatialReferenceH hSRS = cache->get(4326);
+    QVERIFY(hSRS != NULL);
+    QCOMPARE(cache->get(4326), hSRS);
+    QCOMPARE(cache->wkt(4326).empty(), false);
+    OGRErr eErr = OGRERR_NONE;
+    QVERIFY(cache->get(999999, &eErr) == NULL);
+    QVERIFY(eErr != OGRERR_NONE);
+    QCOMPARE(cache->wkt(999999).empty(), true);
+    OGRSpatialReferenceH hSource = cache->get(21781);
+    OGRCoordinateTransformationH hCT = cache->acquire(hSource, 4326);
+    QVERIFY(hCT != NULL);
+    // in use, a second caller gets its own transformation
+    OGRCoordinateTransformationH hOther = cache->acquire(hSource, 4326);
+    QVERIFY(hOther != NULL && hOther != hCT);
+    cache->release(hOther);
+    cache->release(hCT);
+    OGRCoordinateTransformationH hReused = cache->acquire(hSource, 4326);
+    QVERIFY(hReused == hCT || hReused == hOther);
+    cache->release(hReused);
+    cache->clear();
+}
+
+void TestOgr::testTransformBatch() {
+    double x[2] = { 180.0, 8.8 };
+    double y[2] = { 0.0, 47.2 };
+    int success[2] = { FALSE, FALSE };
+    TransformBatch::forwardMercator(2, x, y, success);
+    QVERIFY(success[0] && success[1]);
+    QVERIFY(qAbs(x[0] - 20037508.342789244) < 1e-6);
+    QVERIFY(qAbs(y[0]) < 1e-6);
+    TransformBatch::inverseMercator(2, x, y, success);
+    QVERIFY(qAbs(x[1] - 8.8) < 1e-9 && qAbs(y[1] - 47.2) < 1e-9);
+    double pole[1] = { 90.0 };
+    TransformBatch::forwardMercator(1, x, pole, success);
+    QCOMPARE(success[0], static_cast<int>(FALSE));
+
+    // the fast path gives the same coordinates as the transformation
+    SrsCache *cache = SrsCache::getInstance();
+    OGRSpatialReferenceH hSource = cache->get(4326);
+    OGRSpatialReferenceH hTarget = cache->get(3857);
+    OGRCoordinateTransformationH hCT = cache->acquire(hSource, 3857);
+    QVERIFY(hCT != NULL);
+    OGRGeometryH line = OGR_G_CreateGeometry(wkbLineString);
+    OGR_G_AddPoint_2D(line, 8.8, 47.2);
+    OGR_G_AddPoint_2D(line, -70.5, -33.4);
+    OGRGeometryH expected = OGR_G_Clone(line);
+    QCOMPARE(OGR_G_Transform(expected, hCT), OGRERR_NONE);
+    TransformBatch batch(hCT, hSource, hTarget);
+    batch.add(line);
+    QCOMPARE(batch.size(), 2);
+    QCOMPARE(batch.flush(), OGRERR_NONE);
+    QCOMPARE(OGR_G_GetCoordinateDimension(line), 2);
+    for(int i = 0; i < 2; ++i) {
+        QVERIFY(qAbs(OGR_G_GetX(line, i) - OGR_G_GetX(expected, i)) < 1e-3);
+        QVERIFY(qAbs(OGR_G_GetY(line, i) - OGR_G_GetY(expected, i)) < 1e-3);
+    }
+    OGR_G_DestroyGeometry(expected);
+    OGR_G_DestroyGeometry(line);
+    cache->release(hCT);
+}
+
+void TestOgr::testSourceCatalog() {
+    string sourcename = path + filename;
+    string epsg;
+    string query;
+    string error;
+    bool resVal = ogr->openSource(sourcename, epsg, query, error);
+    QCOMPARE(resVal, true);
+    QList<LayerInfo> layers = ogr->getSourceLayers();
+    const QStringList files = ogr->getSourceFiles();
+    ogr->closeSource();
+    QCOMPARE(layers.size(), 1);
+    QVERIFY(files.size() > 1);
+    SourceCatalog::store(QString::fromStdString(sourcename), layers);
+    QList<LayerInfo> cached;
+    resVal = SourceCatalog::lookup(QString::fromStdString(sourcename), cached);
+    QCOMPARE(resVal, true);
+    QCOMPARE(cached.size(), 1);
+    QCOMPARE(cached.first().name, layers.first().name);
+    QCOMPARE(cached.first().features, layers.first().features);
+    resVal = SourceCatalog::lookup(QString::fromStdString(path) + "unknown.shp", cached);
+    QCOMPARE(resVal, false);
+    // a changed sidecar makes the entry stale, checked on copies
+    QTemporaryDir temp;
+    QVERIFY(temp.isValid());
+    QStringList copies;
+    foreach(const QString file, files) {
+        copies << QDir(temp.path()).filePath(QFileInfo(file).fileName());
+        QVERIFY(QFile::copy(file, copies.last()));
+    }
+    SourceCatalog::store(copies.first(), layers, copies.mid(1));
+    QCOMPARE(SourceCatalog::lookup(copies.first(), cached), true);
+    QFile sidecar(copies.last());
+    QVERIFY(sidecar.open(QIODevice::Append));
+    sidecar.write(" ");
+    sidecar.close();
+    QCOMPARE(SourceCatalog::lookup(copies.first(), cached), false);
+}
+
+void TestOgr::testProjectionSearch() {
+    QList<QPair<QString, QString> > projections;
+    projections << QPair<QString, QString>()
+                << QPair<QString, QString>("2056", "CH1903+ / LV95")
+                << QPair<QString, QString>("21781", "CH1903 / LV03")
+                << QPair<QString, QString>("3857", "WGS 84 / Pseudo-Mercator")
+                << QPair<QString, QString>("4326", "WGS 84")
+                << QPair<QString, QString>("23", "Test");
+    ProjectionSearch search;
+    search.build(projections);
+    QCOMPARE(search.find("4326"), 4);
+    QCOMPARE(search.find("432"), -1);
+    QCOMPARE(search.findPrefix("2"), 5);
+    QCOMPARE(search.findPrefix("20"), 1);
+    // numerically smallest first, not the first codes in text order
+    QCOMPARE(search.search("2", 2), QList<int>() << 5 << 1);
+    QCOMPARE(search.findPrefix("217"), 2);
+    QCOMPARE(search.findPrefix("5"), -1);
+    QList<int> rows = search.search("wgs 84", 10);
+    QCOMPARE(rows.size(), 2);
+    QCOMPARE(rows.first(), 4);
+    rows = search.search("lv03", 10);
+    QCOMPARE(rows.first(), 2);
+    QCOMPARE(search.search("ch", 10).size(), 2);
+}
+
+void TestOgr::testConversionSpec() {
+    ConversionSpec spec;
+    spec.targetFormat = "ESRI Shapefile";
+    spec.target = "C:\\out dir\\";
+    spec.source = "poly.shp";
+    spec.sourceSrs = "21781";
+    spec.targetSrs = "4326";
+    spec.sql = "SELECT * FROM poly WHERE name = \"a b\"";
+    spec.overwrite = true;
+    spec.extraArguments = ConversionSpec::tokenize("-nlt POLYGON -lco \"ENCODING=UTF-8\"");
+    QCOMPARE(spec.extraArguments.size(), 4);
+    QStringList arguments = spec.arguments();
+    QCOMPARE(arguments.mid(0, 4), QStringList() << "-f" << "ESRI Shapefile" << "C:\\out dir\\" << "poly.shp");
+    QVERIFY(arguments.contains("-overwrite"));
+    QCOMPARE(ConversionSpec::tokenize(spec.command()), QStringList() << "ogr2ogr" << arguments);
+    QCOMPARE(spec.options().size(), arguments.size() - 2);
+    QVERIFY(!spec.options().contains("poly.shp"));
+    ConversionSpec parsed = ConversionSpec::fromArguments(arguments);
+    QCOMPARE(parsed.target, spec.target);
+    QCOMPARE(parsed.source, spec.source);
+    QCOMPARE(parsed.arguments(), arguments);
+    QCOMPARE(spec.isIdempotent(), true);
+    spec.overwrite = false;
+    spec.append = true;
+    QCOMPARE(spec.isIdempotent(), false);
+}
+
+void TestOgr::testPreflight() {
+    PreflightRequest request;
+    request.source = QString::fromStdString(path + filename);
+    request.targetFormat = "ESRI Shapefile";
+    request.targetProjection = 4326;
+    request.testFeatures = true;
+    request.samples = 10;
+    PreflightReport report = Preflight::run(ogr, request);
+    QCOMPARE(report.sourceOpened, true);
+    QCOMPARE(report.driverFound, true);
+    QCOMPARE(report.projectionValid, true);
+    request.targetFormat = "GeoJSON";
+    report = Preflight::run(ogr, request);
+    QCOMPARE(report.driverFound, true);
+    // same request without the target driver, only the cache still finds it
+    GDALDriverH hDriver = GDALGetDriverByName("GeoJSON");
+    QVERIFY(hDriver != NULL);
+    GDALDeregisterDriver(hDriver);
+    report = Preflight::run(ogr, request);
+    GDALRegisterDriver(hDriver);
+    QCOMPARE(report.sourceOpened, true);
+    QCOMPARE(report.driverFound, true);
+    QCOMPARE(report.featuresTransformed, true);
+    request.query = "SELECT * FROM unknown";
+    request.targetFormat = "unknown";
+    report = Preflight::run(ogr, request);
+    QCOMPARE(report.queryValid, false);
+    QCOMPARE(report.driverFound, false);
+    ogr->closeSource();
+}
+
+void TestOgr::testTranslateFalseInput() {
+    Ogr2ogrEngine engine;
+    ConversionSpec spec;
+    bool resVal = engine.translate(spec);
+    QCOMPARE(resVal, false);
+    spec.targetFormat = "ESRI Shapefile";
+    spec.target = "out.shp";
+    spec.source = QString::fromStdString(filename);
+    resVal = engine.translate(spec);
+    QCOMPARE(resVal, false);
+    QCOMPARE(engine.getError().empty(), false);
+}
+
+void TestOgr::testTranslateFile() {
+    Ogr2ogrEngine engine;
+    const QString sourcename = QString::fromStdString(path + filename);
+    const QString targetname = QString::fromStdString(path) + "poly_engine.sqlite";
+    QFile::remove(targetname);
+    ConversionSpec spec;
+    spec.targetFormat = "SQLite";
+    spec.target = targetname;
+    spec.source = sourcename;
+    bool resVal = engine.translate(spec);
+    QCOMPARE(resVal, true);
+    QCOMPARE(QFile::exists(targetname), true);
+    QFile::remove(targetname);
+}
+
+void TestOgr::testTranslateInputFormat() {
+    Ogr2ogrEngine engine;
+    const QString sourcename = QString::fromStdString(path + filename);
+    const QString targetname = QString::fromStdString(path) + "poly_if.sqlite";
+    QFile::remove(targetname);
+    ConversionSpec spec;
+    spec.targetFormat = "SQLite";
+    spec.target = targetname;
+    spec.source = sourcename;
+    spec.inputFormat = "ESRI Shapefile";
+    bool resVal = engine.translate(spec);
+    QCOMPARE(resVal, true);
+    QFile::remove(targetname);
+    // a wrong input format falls back to probing all drivers
+    spec.inputFormat = "GPKG";
+    resVal = engine.translate(spec);
+    QCOMPARE(resVal, true);
+    QFile::remove(targetname);
+}
+
+void TestOgr::testTranslateReprojected() {
+    Ogr2ogrEngine engine;
+    const QString sourcename = QString::fromStdString(path + filename);
+    const QString batched = QString::fromStdString(path) + "poly_batched.sqlite";
+    const QString plain = QString::fromStdString(path) + "poly_plain.sqlite";
+    QFile::remove(batched);
+    QFile::remove(plain);
+    ConversionSpec spec;
+    spec.targetFormat = "SQLite";
+    spec.target = batched;
+    spec.source = sourcename;
+    spec.targetSrs = "4326";
+    bool resVal = engine.translate(spec);
+    QCOMPARE(resVal, true);
+    // -dim works on source coordinates, ogr2ogr reprojects by itself then
+    spec.target = plain;
+    spec.extraArguments << "-dim" << "2";
+    resVal = engine.translate(spec);
+    QCOMPARE(resVal, true);
+    OGRDataSourceH hBatched = OGROpen(batched.toUtf8().constData(), FALSE, NULL);
+    OGRDataSourceH hPlain = OGROpen(plain.toUtf8().constData(), FALSE, NULL);
+    QVERIFY(hBatched != NULL && hPlain != NULL);
+    OGRLayerH hBatchedLayer = OGR_DS_GetLayer(hBatched, 0);
+    OGRLayerH hPlainLayer = OGR_DS_GetLayer(hPlain, 0);
+    QCOMPARE(OGR_L_GetFeatureCount(hBatchedLayer, TRUE), OGR_L_GetFeatureCount(hPlainLayer, TRUE));
+    OGREnvelope batchedExtent, plainExtent;
+    QCOMPARE(OGR_L_GetExtent(hBatchedLayer, &batchedExtent, TRUE), OGRERR_NONE);
+    QCOMPARE(OGR_L_GetExtent(hPlainLayer, &plainExtent, TRUE), OGRERR_NONE);
+    QVERIFY(qAbs(batchedExtent.MinX - plainExtent.MinX) < 1e-9 && qAbs(batchedExtent.MaxY - plainExtent.MaxY) < 1e-9);
+    OGR_DS_Destroy(hBatched);
+    OGR_DS_Destroy(hPlain);
+    QFile::remove(batched);
+    QFile::remove(plain);
+}
+
+void TestOgr::testTranslateCancelled() {
+    Ogr2ogrEngine engine;
+    const QString sourcename = QString::fromStdString(path + filename);
+    const QString targetname = QString::fromStdString(path) + "poly_cancelled.sqlite";
+    QFile::remove(targetname);
+    ConversionSpec spec;
+    spec.targetFormat = "SQLite";
+    spec.target = targetname;
+    spec.source = sourcename;
+    // stopped at the first feature read, the created target is removed
+    engine.cancel();
+    bool resVal = engine.translate(spec);
+    QCOMPARE(resVal, false);
+    QCOMPARE(QString::fromStdString(engine.getError()), QString("cancelled by user"));
+    QCOMPARE(QFile::exists(targetname), false);
 }
@@ -0,0 +1,185 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file transformBatch.cpp
+ *	\brief Batched Coordinate Transformation
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "transformBatch.h"
+
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+    // sphere of EPSG 3857, no datum shift to WGS 84
+    const double radius = 6378137.0;
+    const double toRadians = M_PI / 180.0;
+    const double toDegrees = 180.0 / M_PI;
+
+    // longitudes wrapped to [-180, 180] as proj does without +over
+    inline double wrap(double longitude) {
+        if(longitude < -180.0 || longitude > 180.0)
+            longitude -= 360.0 * std::floor((longitude + 180.0) / 360.0);
+        return longitude;
+    }
+}
+
+TransformBatch::TransformBatch(OGRCoordinateTransformationH hCT, OGRSpatialReferenceH source, OGRSpatialReferenceH target) : hCT(hCT), target(target), kernel(Generic) {
+    const int sourceCode = epsg(source);
+    const int targetCode = epsg(target);
+    if(sourceCode == 4326 && targetCode == 3857)
+        kernel = Forward;
+    else if(sourceCode == 3857 && targetCode == 4326)
+        kernel = Inverse;
+}
+
+int TransformBatch::epsg(OGRSpatialReferenceH hSRS) {
+    if(hSRS == NULL)
+        return 0;
+    const char *pszName = OSRGetAuthorityName(hSRS, NULL);
+    const char *pszCode = OSRGetAuthorityCode(hSRS, NULL);
+    if(pszName == NULL || pszCode == NULL || strcmp(pszName, "EPSG") != 0)
+        return 0;
+    // axis order of 4326 in GDAL 2 is longitude, latitude as in the formulas
+    return atoi(pszCode);
+}
+
+void TransformBatch::add(OGRGeometryH geometry) {
+    if(geometry == NULL)
+        return;
+    geometries.append(geometry);
+    gather(geometry);
+}
+
+void TransformBatch::gather(OGRGeometryH geometry) {
+    // polygons, collections and compound curves are walked down to their
+    // points and line strings
+    const int count = OGR_G_GetGeometryCount(geometry);
+    if(count > 0) {
+        for(int i = 0; i < count; ++i)
+            gather(OGR_G_GetGeometryRef(geometry, i));
+        return;
+    }
+    const int points = OGR_G_GetPointCount(geometry);
+    if(points <= 0)
+        return;
+    Part part;
+    part.geometry = geometry;
+    part.first = x.size();
+    part.count = points;
+    part.is3D = OGR_G_Is3D(geometry);
+    part.measured = OGR_G_IsMeasured(geometry);
+    parts.append(part);
+    const int size = part.first + points;
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+    m.resize(size);
+    OGR_G_GetPointsZM(geometry,
+                      x.data() + part.first, sizeof(double),
+                      y.data() + part.first, sizeof(double),
+                      z.data() + part.first, sizeof(double),
+                      m.data() + part.first, sizeof(double));
+}
+
+OGRErr TransformBatch::flush(void) {
+    const int count = x.size();
+    if(count == 0) {
+        clear();
+        return OGRERR_NONE;
+    }
+    success.fill(TRUE, count);
+    switch(kernel) {
+    case Forward :
+        forwardMercator(count, x.data(), y.data(), success.data());
+        break;
+    case Inverse :
+        inverseMercator(count, x.data(), y.data(), success.data());
+        break;
+    default :
+        // one call for the whole batch instead of one per geometry
+        if(hCT == NULL || !OCTTransformEx(hCT, count, x.data(), y.data(), z.data(), success.data())) {
+            clear();
+            return OGRERR_FAILURE;
+        }
+        break;
+    }
+    for(int i = 0; i < count; ++i) {
+        if(!success.at(i)) {
+            clear();
+            return OGRERR_FAILURE;
+        }
+    }
+    foreach(const Part &part, parts) {
+        OGR_G_SetPointsZM(part.geometry, part.count,
+                          x.data() + part.first, sizeof(double),
+                          y.data() + part.first, sizeof(double),
+                          part.is3D ? z.data() + part.first : NULL, sizeof(double),
+                          part.measured ? m.data() + part.first : NULL, sizeof(double));
+    }
+    foreach(OGRGeometryH geometry, geometries)
+        OGR_G_AssignSpatialReference(geometry, target);
+    clear();
+    return OGRERR_NONE;
+}
+
+int TransformBatch::size(void) const {
+    return x.size();
+}
+
+void TransformBatch::clear(void) {
+    geometries.clear();
+    parts.clear();
+    x.clear();
+    y.clear();
+    z.clear();
+    m.clear();
+}
+
+void TransformBatch::forwardMercator(const int count, double *x, double *y, int *success) {
+    // separate passes over contiguous arrays, the scaling loops vectorize
+    for(int i = 0; i < count; ++i)
+        success[i] = std::fabs(y[i]) < 90.0;
+    for(int i = 0; i < count; ++i)
+        x[i] = wrap(x[i]);
+    for(int i = 0; i < count; ++i)
+        x[i] *= radius * toRadians;
+    for(int i = 0; i < count; ++i)
+        y[i] = radius * std::log(std::tan(M_PI / 4.0 + 0.5 * toRadians * y[i]));
+}
+
+void TransformBatch::inverseMercator(const int count, double *x, double *y, int *success) {
+    for(int i = 0; i < count; ++i)
+        success[i] = std::isfinite(x[i]) && std::isfinite(y[i]);
+    for(int i = 0; i < count; ++i)
+        x[i] *= toDegrees / radius;
+    for(int i = 0; i < count; ++i)
+        x[i] = wrap(x[i]);
+    for(int i = 0; i < count; ++i)
+        y[i] = toDegrees * (M_PI / 2.0 - 2.0 * std::atan(std::exp(-y[i] / radius)));
+}
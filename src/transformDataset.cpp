@@ -0,0 +1,312 @@
+/*****************************************************************************
+ * OGR2GUI is an application used to convert and manipulate geospatial
+ * data. It is based on the "OGR Simple Feature Library" from the
+ * "Geospatial Data Abstraction Library" <http://gdal.org>.
+ *
+ * Copyright (c) 2014 Faculty of Computer Science,
+ * University of Applied Sciences Rapperswil (HSR),
+ * 8640 Rapperswil, Switzerland
+ * Copyright (c) 2016 David Tran, Switzerland
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/*!
+ *	\file transformDataset.cpp
+ *	\brief Reprojecting Source Dataset
+ *	\author David Tran [HSR]
+ *	\version 0.8
+ */
+
+#include "transformDataset.h"
+#include "srsCache.h"
+
+TransformLayer::TransformLayer(OGRLayer *poSrcLayer, OGRCoordinateTransformationH hCT, OGRSpatialReferenceH source, OGRSpatialReferenceH target, const bool skipFailures,
+                               TransformContinueFunc pfnContinue, void *pContinueArg)
+    : poSrcLayer(poSrcLayer), hCT(hCT), target(target), batch(hCT, source, target), skipFailures(skipFailures),
+      pfnContinue(pfnContinue), pContinueArg(pContinueArg), failed(false) {
+}
+
+TransformLayer::~TransformLayer(void) {
+    clear();
+    SrsCache::getInstance()->release(hCT);
+}
+
+void TransformLayer::clear(void) {
+    while(!features.isEmpty())
+        OGRFeature::DestroyFeature(features.dequeue());
+}
+
+bool TransformLayer::transform(OGRFeature *poFeature) {
+    if(hCT == NULL)
+        return true;
+    batch.add(reinterpret_cast<OGRGeometryH>(poFeature->GetGeometryRef()));
+    if(batch.flush() == OGRERR_NONE)
+        return true;
+    CPLError(skipFailures ? CE_Warning : CE_Failure, CPLE_AppDefined,
+             "Failed to reproject feature " CPL_FRMT_GIB " (geometry probably out of source or destination SRS).", poFeature->GetFID());
+    return false;
+}
+
+bool TransformLayer::fill(void) {
+    // features passed through are not read ahead
+    const int size = hCT != NULL ? batchSize : 1;
+    QVector<OGRFeature*> read;
+    read.reserve(size);
+    OGRFeature *poFeature;
+    while(read.size() < size && (poFeature = poSrcLayer->GetNextFeature()) != NULL) {
+        read.append(poFeature);
+        if(hCT != NULL)
+            batch.add(reinterpret_cast<OGRGeometryH>(poFeature->GetGeometryRef()));
+    }
+    if(batch.flush() != OGRERR_NONE) {
+        // the batch is left unchanged, the failing features are searched
+        // one by one and handled as ogr2ogr does
+        for(int i = 0; i < read.size(); ++i) {
+            if(transform(read.at(i)))
+                continue;
+            if(!skipFailures) {
+                failed = true;
+                for(int j = i; j < read.size(); ++j)
+                    OGRFeature::DestroyFeature(read.at(j));
+                read.resize(i);
+                break;
+            }
+            OGRFeature::DestroyFeature(read.at(i));
+            read.remove(i--);
+        }
+    }
+    foreach(OGRFeature *poRead, read)
+        features.enqueue(poRead);
+    return !features.isEmpty();
+}
+
+void TransformLayer::ResetReading(void) {
+    clear();
+    failed = false;
+    poSrcLayer->ResetReading();
+}
+
+OGRFeature *TransformLayer::GetNextFeature(void) {
+    if(pfnContinue != NULL && !pfnContinue(pContinueArg))
+        return NULL;
+    while(features.isEmpty()) {
+        if(failed || !fill())
+            return NULL;
+    }
+    return features.dequeue();
+}
+
+OGRErr TransformLayer::SetNextByIndex(GIntBig nIndex) {
+    clear();
+    return poSrcLayer->SetNextByIndex(nIndex);
+}
+
+OGRFeature *TransformLayer::GetFeature(GIntBig nFID) {
+    OGRFeature *poFeature = poSrcLayer->GetFeature(nFID);
+    if(poFeature != NULL && !transform(poFeature)) {
+        OGRFeature::DestroyFeature(poFeature);
+        return NULL;
+    }
+    return poFeature;
+}
+
+OGRFeatureDefn *TransformLayer::GetLayerDefn(void) {
+    return poSrcLayer->GetLayerDefn();
+}
+
+const char *TransformLayer::GetName(void) {
+    return poSrcLayer->GetName();
+}
+
+OGRwkbGeometryType TransformLayer::GetGeomType(void) {
+    return poSrcLayer->GetGeomType();
+}
+
+OGRSpatialReference *TransformLayer::GetSpatialRef(void) {
+    if(target == NULL)
+        return poSrcLayer->GetSpatialRef();
+    return reinterpret_cast<OGRSpatialReference*>(target);
+}
+
+GIntBig TransformLayer::GetFeatureCount(int bForce) {
+    return poSrcLayer->GetFeatureCount(bForce);
+}
+
+OGRGeometry *TransformLayer::GetSpatialFilter(void) {
+    return poSrcLayer->GetSpatialFilter();
+}
+
+void TransformLayer::SetSpatialFilter(OGRGeometry *poGeom) {
+    // -spat is given in source coordinates, as with -t_srs
+    clear();
+    poSrcLayer->SetSpatialFilter(poGeom);
+}
+
+void TransformLayer::SetSpatialFilter(int iGeomField, OGRGeometry *poGeom) {
+    clear();
+    poSrcLayer->SetSpatialFilter(iGeomField, poGeom);
+}
+
+OGRErr TransformLayer::SetAttributeFilter(const char *pszQuery) {
+    clear();
+    return poSrcLayer->SetAttributeFilter(pszQuery);
+}
+
+OGRErr TransformLayer::SetIgnoredFields(const char **papszFields) {
+    return poSrcLayer->SetIgnoredFields(papszFields);
+}
+
+const char *TransformLayer::GetFIDColumn(void) {
+    return poSrcLayer->GetFIDColumn();
+}
+
+const char *TransformLayer::GetGeometryColumn(void) {
+    return poSrcLayer->GetGeometryColumn();
+}
+
+OGRStyleTable *TransformLayer::GetStyleTable(void) {
+    return poSrcLayer->GetStyleTable();
+}
+
+char **TransformLayer::GetMetadata(const char *pszDomain) {
+    return poSrcLayer->GetMetadata(pszDomain);
+}
+
+const char *TransformLayer::GetMetadataItem(const char *pszName, const char *pszDomain) {
+    return poSrcLayer->GetMetadataItem(pszName, pszDomain);
+}
+
+int TransformLayer::TestCapability(const char *pszCap) {
+    // read only, the extent of the source is in its own coordinates
+    if(EQUAL(pszCap, OLCFastFeatureCount) || EQUAL(pszCap, OLCRandomRead) || EQUAL(pszCap, OLCFastSetNextByIndex) ||
+            EQUAL(pszCap, OLCFastSpatialFilter) || EQUAL(pszCap, OLCIgnoreFields) || EQUAL(pszCap, OLCStringsAsUTF8) ||
+            EQUAL(pszCap, OLCCurveGeometries) || EQUAL(pszCap, OLCMeasuredGeometries))
+        return poSrcLayer->TestCapability(pszCap);
+    return FALSE;
+}
+
+bool TransformLayer::isFailed(void) const {
+    return failed;
+}
+
+TransformDataset::TransformDataset(GDALDataset *poSrcDS, const bool skipFailures, TransformContinueFunc pfnContinue, void *pContinueArg)
+    : poSrcDS(poSrcDS), skipFailures(skipFailures), pfnContinue(pfnContinue), pContinueArg(pContinueArg) {
+    poDriver = poSrcDS->GetDriver();
+    SetDescription(poSrcDS->GetDescription());
+}
+
+TransformDataset::~TransformDataset(void) {
+    foreach(OGRLayer *poLayer, results.keys())
+        ReleaseResultSet(poLayer);
+    foreach(TransformLayer *layer, layers)
+        delete layer;
+}
+
+TransformDataset* TransformDataset::create(GDALDatasetH hDS, const int target, const bool skipFailures,
+                                           TransformContinueFunc pfnContinue, void *pContinueArg) {
+    GDALDataset *poSrcDS = reinterpret_cast<GDALDataset*>(hDS);
+    OGRSpatialReferenceH hTarget = target > 0 ? SrsCache::getInstance()->get(target) : NULL;
+    if(poSrcDS == NULL || (target > 0 && hTarget == NULL))
+        return NULL;
+    // interleaved layers, as in OSM, are read through the dataset itself
+#ifdef ODsCRandomLayerRead
+    const bool interleaved = poSrcDS->TestCapability(ODsCRandomLayerRead);
+#else
+    // GDAL 2.1 has no capability for it, OSM is its only such driver
+    const bool interleaved = poSrcDS->GetDriver() != NULL && EQUAL(poSrcDS->GetDriver()->GetDescription(), "OSM");
+#endif
+    if(interleaved)
+        return NULL;
+    TransformDataset *poDS = new TransformDataset(poSrcDS, skipFailures, pfnContinue, pContinueArg);
+    for(int i = 0; i < poSrcDS->GetLayerCount(); ++i) {
+        OGRLayer *poLayer = poSrcDS->GetLayer(i);
+        OGRFeatureDefn *poDefn = poLayer->GetLayerDefn();
+        if(target == 0) {
+            poDS->layers.append(new TransformLayer(poLayer, NULL, NULL, NULL, skipFailures, pfnContinue, pContinueArg));
+            continue;
+        }
+        if(poDefn->GetGeomFieldCount() == 0) {
+            poDS->layers.append(new TransformLayer(poLayer, NULL, NULL, hTarget, skipFailures, pfnContinue, pContinueArg));
+            continue;
+        }
+        OGRSpatialReference *poSRS = poDefn->GetGeomFieldDefn(0)->GetSpatialRef();
+        OGRCoordinateTransformationH hCT = NULL;
+        if(poDefn->GetGeomFieldCount() == 1 && poSRS != NULL)
+            hCT = SrsCache::getInstance()->acquire(reinterpret_cast<OGRSpatialReferenceH>(poSRS), target);
+        if(hCT == NULL) {
+            delete poDS;
+            return NULL;
+        }
+        // .prj files rarely carry an authority, the kernel is picked on an
+        // identified copy
+        OGRSpatialReference *poIdentified = poSRS->Clone();
+        poIdentified->AutoIdentifyEPSG();
+        poDS->layers.append(new TransformLayer(poLayer, hCT, reinterpret_cast<OGRSpatialReferenceH>(poIdentified), hTarget, skipFailures, pfnContinue, pContinueArg));
+        poIdentified->Release();
+    }
+    return poDS;
+}
+
+int TransformDataset::GetLayerCount(void) {
+    return layers.size();
+}
+
+OGRLayer *TransformDataset::GetLayer(int iLayer) {
+    if(iLayer < 0 || iLayer >= layers.size())
+        return NULL;
+    return layers.at(iLayer);
+}
+
+OGRStyleTable *TransformDataset::GetStyleTable(void) {
+    return poSrcDS->GetStyleTable();
+}
+
+char **TransformDataset::GetMetadata(const char *pszDomain) {
+    return poSrcDS->GetMetadata(pszDomain);
+}
+
+const char *TransformDataset::GetMetadataItem(const char *pszName, const char *pszDomain) {
+    return poSrcDS->GetMetadataItem(pszName, pszDomain);
+}
+
+int TransformDataset::TestCapability(const char *) {
+    return FALSE;
+}
+
+OGRLayer *TransformDataset::ExecuteSQL(const char *pszStatement, OGRGeometry *poSpatialFilter, const char *pszDialect) {
+    // run by the source in its own dialect, the result is passed through
+    OGRLayer *poResult = poSrcDS->ExecuteSQL(pszStatement, poSpatialFilter, pszDialect);
+    if(poResult == NULL)
+        return NULL;
+    OGRLayer *poLayer = new TransformLayer(poResult, NULL, NULL, NULL, skipFailures, pfnContinue, pContinueArg);
+    results.insert(poLayer, poResult);
+    return poLayer;
+}
+
+void TransformDataset::ReleaseResultSet(OGRLayer *poResultsSet) {
+    if(!results.contains(poResultsSet))
+        return;
+    OGRLayer *poResult = results.take(poResultsSet);
+    delete poResultsSet;
+    poSrcDS->ReleaseResultSet(poResult);
+}
+
+bool TransformDataset::isFailed(void) const {
+    foreach(TransformLayer *layer, layers) {
+        if(layer->isFailed())
+            return true;
+    }
+    return false;
+}